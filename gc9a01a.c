@@ -16,12 +16,71 @@
  ******************************************************************************
  */
 #include "gc9a01a.h"
+#include "gc9a01a_glyph_cache.h"
+#include "gc9a01a_internal.h"
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
-extern SPI_HandleTypeDef GC9A01A_SPI;
+#ifndef __weak
+#define __weak __attribute__((weak))
+#endif
+
+#ifdef GC9A01A_DEFAULT_TRANSPORT
+extern const gc9a01a_transport_t GC9A01A_DEFAULT_TRANSPORT;
+static const gc9a01a_transport_t *bus = &GC9A01A_DEFAULT_TRANSPORT;
+#else
+static const gc9a01a_transport_t *bus = NULL;
+#endif
+
+#if (GC9A01A_TX_BUF_SIZE % 2) != 0
+#error "GC9A01A_TX_BUF_SIZE must hold a whole number of RGB565 pixels"
+#endif
+
+#if GC9A01A_FRAMEBUFFER && GC9A01A_BAND_LINES
+#error "GC9A01A_FRAMEBUFFER and GC9A01A_BAND_LINES are exclusive"
+#endif
+
+#if GC9A01A_FRAME_DIFF && !(GC9A01A_FRAMEBUFFER || GC9A01A_BAND_LINES)
+#error "GC9A01A_FRAME_DIFF needs GC9A01A_FRAMEBUFFER or GC9A01A_BAND_LINES"
+#endif
+
+// primitives render into memory instead of the panel address window
+#if GC9A01A_FRAMEBUFFER || GC9A01A_BAND_LINES
+#define GC9A01A_OFFSCREEN 1
+#else
+#define GC9A01A_OFFSCREEN 0
+#endif
 
 #if USE_DMA
-static volatile uint8_t tx_busy = 0;
+#define TX_BUF_COUNT GC9A01A_TX_BUF_COUNT
+#if TX_BUF_COUNT < 2
+#error "GC9A01A_TX_BUF_COUNT must be at least 2 to overlap filling and sending"
+#endif
+#else
+#define TX_BUF_COUNT 1
+#endif
+
+static uint8_t tx_bufs[TX_BUF_COUNT][GC9A01A_TX_BUF_SIZE];
+static uint8_t *tx_buf = tx_bufs[0];  ///< RGB565 big-endian pixels being filled by the CPU
+static uint32_t tx_len = 0;
+
+#if USE_DMA
+static uint32_t tx_sizes[TX_BUF_COUNT];
+static uint8_t tx_fill = 0;                ///< Index of the buffer filled by the CPU
+static volatile uint8_t tx_head = 0;       ///< Index of the next buffer to send (ISR owned)
+static volatile uint8_t tx_submitted = 0;  ///< Buffers handed to the DMA (CPU owned)
+static volatile uint8_t tx_completed = 0;  ///< Buffers sent by the DMA (ISR owned)
+static volatile uint8_t tx_busy = 0;       ///< A DMA transfer is running
+static volatile uint8_t tx_release = 0;    ///< Release CS and notify once the queue drains
+static uint8_t tx_notify = 0;              ///< Pixel data was queued in this transaction
+#endif
+
+#if GC9A01A_ENABLE_STATS
+static gc9a01a_stats_t stats;
+#define GC9A01A_STATS_ADD(field, n) (stats.field += (n))
+#else
+#define GC9A01A_STATS_ADD(field, n) ((void)0)
 #endif
 
 static inline void swap_int16_t(int16_t *a, int16_t *b) {
@@ -32,63 +91,326 @@ static inline void swap_int16_t(int16_t *a, int16_t *b) {
 
 /*Internal GPIO control -----------------------------------------*/
 
+static uint8_t transaction_depth = 0;  ///< Nesting level of begin/end transaction calls
+static uint8_t dc_state = 0xFF;        ///< Last level driven on DC, 0xFF when unknown
+
+/**
+ * Last column/row range sent to the panel and the position where the next
+ * pixel of an open memory write will land, used to skip redundant CASET and
+ * RASET commands and to continue streaming with Write Memory Continue.
+ */
+static struct
+{
+    uint16_t x0, x1;
+    uint16_t y0, y1;
+    uint16_t cursor_x, cursor_y;
+    uint8_t columns_valid;
+    uint8_t rows_valid;
+    uint8_t writing;
+} window;
+
+static inline void gc9a01a_window_invalidate(void) {
+    window.columns_valid = 0;
+    window.rows_valid = 0;
+    window.writing = 0;
+}
+
 static inline void gc9a01a_chip_select(void) {
-    HAL_GPIO_WritePin(GC9A01A_CS_PORT, GC9A01A_CS_PIN, GPIO_PIN_RESET);
+    bus->set_cs(0);
 }
 static inline void gc9a01a_chip_unselect(void) {
-    HAL_GPIO_WritePin(GC9A01A_CS_PORT, GC9A01A_CS_PIN, GPIO_PIN_SET);
+    bus->set_cs(1);
 }
 static inline void gc9a01a_dc_set_command(void) {
-    HAL_GPIO_WritePin(GC9A01A_DC_PORT, GC9A01A_DC_PIN, GPIO_PIN_RESET);
+    if ((dc_state != 0) && (bus->set_dc != NULL))
+    {
+        bus->set_dc(0);
+        dc_state = 0;
+    }
 }
 static inline void gc9a01a_dc_set_data(void) {
-    HAL_GPIO_WritePin(GC9A01A_DC_PORT, GC9A01A_DC_PIN, GPIO_PIN_SET);
+    if ((dc_state != 1) && (bus->set_dc != NULL))
+    {
+        bus->set_dc(1);
+        dc_state = 1;
+    }
+}
+
+#if USE_DMA
+static inline void gc9a01a_enter_critical(void) {
+    if (bus->enter_critical != NULL)
+    { bus->enter_critical(); }
+}
+static inline void gc9a01a_exit_critical(void) {
+    if (bus->exit_critical != NULL)
+    { bus->exit_critical(); }
+}
+#endif
+
+/**
+ * Wait until every queued pixel buffer has left the SPI, the DC line and
+ * the bus must not change while a DMA transfer is running.
+ */
+static inline void gc9a01a_tx_drain(void) {
+#if USE_DMA
+    while (tx_busy)
+        ;
+#endif
+}
+
+void gc9a01a_set_transport(const gc9a01a_transport_t *transport) {
+    gc9a01a_wait_idle();
+    bus = transport;
+    dc_state = 0xFF;
+    gc9a01a_window_invalidate();
 }
 
+static void gc9a01a_send_cmd(uint8_t cmd);
+
 void gc9a01a_hw_reset(void) {
-    HAL_GPIO_WritePin(GC9A01A_RST_PORT, GC9A01A_RST_PIN, GPIO_PIN_RESET);
-    HAL_Delay(20);
-    HAL_GPIO_WritePin(GC9A01A_RST_PORT, GC9A01A_RST_PIN, GPIO_PIN_SET);
-    HAL_Delay(120);
+    if (bus->set_rst != NULL)
+    {
+        bus->set_rst(0);
+        bus->delay_ms(20);
+        bus->set_rst(1);
+    } else
+    {
+        gc9a01a_begin_transaction();
+        gc9a01a_send_cmd(GC9A01A_SWRESET);
+        gc9a01a_end_transaction();
+    }
+    bus->delay_ms(120);
+    gc9a01a_window_invalidate();
+    gc9a01a_invalidate();
 }
 
-void gc9a01a_write_cmd(uint8_t cmd) {
-    gc9a01a_chip_select();
+void gc9a01a_begin_transaction(void) {
+    if (transaction_depth++ == 0)
+    {
+        // the previous transaction may still be draining, its CS is
+        // released from the DMA completion interrupt
+        gc9a01a_wait_idle();
+        GC9A01A_STATS_ADD(transactions, 1);
+        gc9a01a_chip_select();
+#if USE_DMA
+        tx_notify = 0;
+#endif
+    }
+}
+
+void gc9a01a_end_transaction(void) {
+    if ((transaction_depth > 0) && (--transaction_depth == 0))
+    {
+#if USE_DMA
+        uint8_t notify = 0;
+
+        gc9a01a_enter_critical();
+        if (tx_busy)
+        {
+            tx_release = 1;
+        } else
+        {
+            gc9a01a_chip_unselect();
+            notify = tx_notify;
+        }
+        gc9a01a_exit_critical();
+        if (notify)
+        { gc9a01a_flush_ready(); }
+#else
+        gc9a01a_chip_unselect();
+#endif
+    }
+}
+
+void gc9a01a_wait_idle(void) {
+#if USE_DMA
+    while (tx_busy || tx_release)
+        ;
+#endif
+}
+
+static void gc9a01a_send_cmd(uint8_t cmd) {
+    GC9A01A_STATS_ADD(commands, 1);
+    gc9a01a_begin_transaction();
+    gc9a01a_tx_drain();
     gc9a01a_dc_set_command();
-    HAL_SPI_Transmit(&GC9A01A_SPI, &cmd, 1, GC9A01A_SPI_TIMEOUT);
-    gc9a01a_chip_unselect();
+    bus->write_command(cmd);
+    gc9a01a_end_transaction();
 }
 
-void gc9a01a_write_data(uint8_t data) {
-    gc9a01a_chip_select();
+static void gc9a01a_send_data(const uint8_t *data, uint32_t size) {
+    GC9A01A_STATS_ADD(data_bytes, size);
+    gc9a01a_begin_transaction();
+    gc9a01a_tx_drain();
     gc9a01a_dc_set_data();
-    HAL_SPI_Transmit(&GC9A01A_SPI, &data, 1, GC9A01A_SPI_TIMEOUT);
-    gc9a01a_chip_unselect();
+    bus->write_data(data, size);
+    gc9a01a_end_transaction();
+}
+
+void gc9a01a_write_cmd(uint8_t cmd) {
+    // any command sent from outside may move or reset the address window
+    gc9a01a_window_invalidate();
+    gc9a01a_send_cmd(cmd);
+}
+
+void gc9a01a_write_data(uint8_t data) {
+    gc9a01a_write_data_buf(&data, 1);
 }
 
 void gc9a01a_write_data_buf(uint8_t *data, uint32_t size) {
-    gc9a01a_chip_select();
-    gc9a01a_dc_set_data();
+    window.writing = 0;
+    gc9a01a_send_data(data, size);
+}
+
+/*Pixel transmit buffer -----------------------------------------*/
+
 #if USE_DMA
+static inline void gc9a01a_dma_start(uint8_t index) {
     tx_busy = 1;
-    HAL_SPI_Transmit_DMA(&GC9A01A_SPI, data, size);
-#else
-    HAL_SPI_Transmit(&GC9A01A_SPI, data, size, GC9A01A_SPI_TIMEOUT);
-    gc9a01a_chip_unselect();
+    bus->write_data_async(tx_bufs[index], tx_sizes[index]);
+}
 #endif
+
+/**
+ * Move the cursor of the open memory write past the given number of pixels,
+ * wrapping inside the window like the panel does.
+ */
+static inline void gc9a01a_window_advance(uint32_t count) {
+    if (window.writing)
+    {
+        uint32_t width = window.x1 - window.x0 + 1;
+        uint32_t pixels = width * (window.y1 - window.y0 + 1);
+        uint32_t offset = (window.cursor_y - window.y0) * width + (window.cursor_x - window.x0);
+
+        offset = (offset + count % pixels) % pixels;
+        window.cursor_x = window.x0 + offset % width;
+        window.cursor_y = window.y0 + offset / width;
+    }
 }
 
-// === DMA CALLBACK ===
+/**
+ * Send the filled part of the transmit buffer. With USE_DMA the buffer is
+ * queued and the CPU moves on to the next free one while the DMA drains it,
+ * so it only blocks when all GC9A01A_TX_BUF_COUNT buffers are in flight.
+ */
+static void gc9a01a_tx_flush(void) {
+    if (tx_len == 0)
+        return;
+    gc9a01a_window_advance(tx_len / 2);
 #if USE_DMA
-void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi) {
-    if (hspi == &GC9A01_SPI)
+    if (bus->write_data_async == NULL)
     {
-        GC9A01_Unselect();
-        tx_busy = 0;
-        GC9A01_FlushReady();
+        gc9a01a_send_data(tx_buf, tx_len);
+        tx_len = 0;
+        return;
     }
+    GC9A01A_STATS_ADD(data_bytes, tx_len);
+    gc9a01a_dc_set_data();
+    tx_sizes[tx_fill] = tx_len;
+    tx_notify = 1;
+
+    gc9a01a_enter_critical();
+    tx_submitted++;
+    if (!tx_busy)
+    { gc9a01a_dma_start(tx_head); }
+    gc9a01a_exit_critical();
+
+    tx_fill = (tx_fill + 1) % TX_BUF_COUNT;
+    tx_buf = tx_bufs[tx_fill];
+    while ((uint8_t)(tx_submitted - tx_completed) >= TX_BUF_COUNT)
+        ;
+#else
+    gc9a01a_send_data(tx_buf, tx_len);
+#endif
+    tx_len = 0;
+}
+
+static inline void gc9a01a_tx_push_color(uint16_t color) {
+    tx_buf[tx_len++] = color >> 8;
+    tx_buf[tx_len++] = color & 0xFF;
+    if (tx_len >= GC9A01A_TX_BUF_SIZE)
+    { gc9a01a_tx_flush(); }
 }
+
+#if !GC9A01A_OFFSCREEN
+/**
+ * Send count copies of one color into the open memory write. The bus
+ * replicates the color itself when it can, otherwise every transmit buffer
+ * is filled with the color once and sent as many times as needed.
+ */
+static void gc9a01a_tx_write_color(uint16_t color, uint32_t count) {
+    uint32_t chunk, i;
+
+    // short runs join the pending buffer, long ones go straight to the bus
+    if ((bus->write_color != NULL) && (2 * count > GC9A01A_TX_BUF_SIZE - tx_len))
+    {
+        gc9a01a_tx_flush();
+        GC9A01A_STATS_ADD(data_bytes, 2 * count);
+        gc9a01a_begin_transaction();
+        gc9a01a_tx_drain();
+        gc9a01a_dc_set_data();
+        bus->write_color(color, count);
+        gc9a01a_window_advance(count);
+        gc9a01a_end_transaction();
+        return;
+    }
+
+    while (count > 0)
+    {
+        chunk = (GC9A01A_TX_BUF_SIZE - tx_len) / 2;
+        if (chunk > count)
+        { chunk = count; }
+        for (i = 0; i < chunk; i++)
+        {
+            tx_buf[tx_len++] = color >> 8;
+            tx_buf[tx_len++] = color & 0xFF;
+        }
+        count -= chunk;
+        if (tx_len >= GC9A01A_TX_BUF_SIZE - 1)
+        { gc9a01a_tx_flush(); }
+    }
+}
+#endif
+
+/**
+ * Copy bytes already in bus order into the transmit buffer.
+ */
+static inline void gc9a01a_tx_push_bytes(const uint8_t *data, uint32_t size) {
+    uint32_t chunk;
+
+    while (size > 0)
+    {
+        chunk = GC9A01A_TX_BUF_SIZE - tx_len;
+        if (chunk > size)
+        { chunk = size; }
+        memcpy(&tx_buf[tx_len], data, chunk);
+        tx_len += chunk;
+        data += chunk;
+        size -= chunk;
+        if (tx_len >= GC9A01A_TX_BUF_SIZE)
+        { gc9a01a_tx_flush(); }
+    }
+}
+
+// === DMA COMPLETION ===
+void gc9a01a_transport_tx_complete(void) {
+#if USE_DMA
+    tx_head = (tx_head + 1) % TX_BUF_COUNT;
+    tx_completed++;
+    if (tx_completed != tx_submitted)
+    {
+        gc9a01a_dma_start(tx_head);
+        return;
+    }
+    tx_busy = 0;
+    if (tx_release)
+    {
+        gc9a01a_chip_unselect();
+        tx_release = 0;
+        gc9a01a_flush_ready();
+    }
 #endif
+}
 
 // === OPTIONAL WEAK CALLBACK ===
 __weak void gc9a01a_flush_ready(void) {
@@ -96,312 +418,1229 @@ __weak void gc9a01a_flush_ready(void) {
 }
 
 void gc9a01a_set_address_window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
-    gc9a01a_write_cmd(GC9A01A_CASET);
-    uint8_t column_data[] = {x0 >> 8, x0 & 0xFF, x1 >> 8, x1 & 0xFF};
-    gc9a01a_write_data_buf(column_data, 4);
+    gc9a01a_begin_transaction();
+
+    // the requested pixels directly follow the last ones written, keep streaming:
+    // the panel wraps rows back to window.x0, so a block of rows must use the
+    // same columns, while a single row only has to end inside the window
+    if (window.writing && (x0 == window.cursor_x) && (y0 == window.cursor_y) &&
+        (((x0 == window.x0) && (x1 == window.x1) && (y1 == window.y1)) ||
+         ((y0 == y1) && (x1 <= window.x1))))
+    {
+        gc9a01a_send_cmd(GC9A01A_WMEMC);
+        gc9a01a_end_transaction();
+        return;
+    }
 
-    gc9a01a_write_cmd(GC9A01A_ROW_SET);
-    uint8_t row_data[] = {y0 >> 8, y0 & 0xFF, y1 >> 8, y1 & 0xFF};
-    gc9a01a_write_data_buf(row_data, 4);
-    gc9a01a_write_cmd(GC9A01A_RAM_MEM_WR);
+    if (!window.columns_valid || (x0 != window.x0) || (x1 != window.x1))
+    {
+        uint8_t column_data[] = {x0 >> 8, x0 & 0xFF, x1 >> 8, x1 & 0xFF};
+        gc9a01a_send_cmd(GC9A01A_CASET);
+        gc9a01a_send_data(column_data, 4);
+        window.x0 = x0;
+        window.x1 = x1;
+        window.columns_valid = 1;
+    }
+
+    if (!window.rows_valid || (y0 != window.y0) || (y1 != window.y1))
+    {
+        uint8_t row_data[] = {y0 >> 8, y0 & 0xFF, y1 >> 8, y1 & 0xFF};
+        gc9a01a_send_cmd(GC9A01A_ROW_SET);
+        gc9a01a_send_data(row_data, 4);
+        window.y0 = y0;
+        window.y1 = y1;
+        window.rows_valid = 1;
+    }
+
+    gc9a01a_send_cmd(GC9A01A_RAM_MEM_WR);
+    window.cursor_x = x0;
+    window.cursor_y = y0;
+    window.writing = 1;
+    gc9a01a_end_transaction();
 }
 
-void gc9a01a_configure() {
-    uint8_t params[15];
-    gc9a01a_chip_select();
+/*Round panel mask ----------------------------------------------*/
 
-    gc9a01a_write_cmd(GC9A01A_INREG_ON_1);  ///< Inter register enable 1
-    gc9a01a_write_cmd(GC9A01A_INREG_ON_2);  ///< Inter register enable 2
+#if GC9A01A_ROUND_MASK
+/**
+ * First visible column of each row of the top half of the round glass, the
+ * visible span of row y is [inset, 239 - inset] and the bottom half mirrors
+ * the top one.
+ */
+static uint8_t round_inset[GC9A01A_TFTHEIGHT / 2];
 
-    params[0] = 0x14;
-    gc9a01a_write_cmd(0xEB);
-    gc9a01a_write_data_buf(params, 1);
+static void gc9a01a_mask_init(void) {
+    uint32_t r2 = (uint32_t)GC9A01A_TFTWIDTH * GC9A01A_TFTWIDTH;
+    uint32_t d, half2, half = 0;
+    uint16_t y;
 
-    params[0] = 0x60;
-    gc9a01a_write_cmd(0x84);
-    gc9a01a_write_data_buf(params, 1);
+    // work in half pixels so that the center (119.5, 119.5) is an integer,
+    // the half chord only grows towards the middle row
+    for (y = 0; y < GC9A01A_TFTHEIGHT / 2; y++)
+    {
+        d = (GC9A01A_TFTHEIGHT - 1) - 2 * y;
+        half2 = r2 - d * d;
+        while ((half + 1) * (half + 1) <= half2)
+        { half++; }
+        round_inset[y] = ((GC9A01A_TFTWIDTH - 1) - half + 1) / 2;
+    }
+}
 
-    params[0] = 0xFF;
-    gc9a01a_write_cmd(0x85);
-    gc9a01a_write_data_buf(params, 1);
+/**
+ * Count the rows from y on whose visible part of [x0, x1] is the same span,
+ * returned in [*cx0, *cx1] (empty when *cx0 > *cx1). A side is only clipped
+ * when it saves GC9A01A_ROUND_MASK_MIN pixels, smaller savings do not pay
+ * for the extra window.
+ */
+static uint16_t gc9a01a_mask_rows(uint16_t y, uint16_t y1, uint16_t x0, uint16_t x1, uint16_t *cx0,
+                                  uint16_t *cx1) {
+    uint16_t rows = 0;
+    uint16_t inset, left, right;
 
-    params[0] = 0xFF;
-    gc9a01a_write_cmd(0x86);
-    gc9a01a_write_data_buf(params, 1);
+    do
+    {
+        inset = round_inset[(y < GC9A01A_TFTHEIGHT / 2) ? y : (GC9A01A_TFTHEIGHT - 1 - y)];
+        left = (inset >= x0 + GC9A01A_ROUND_MASK_MIN) ? inset : x0;
+        right = (GC9A01A_TFTWIDTH - 1 - inset + GC9A01A_ROUND_MASK_MIN <= x1)
+                    ? GC9A01A_TFTWIDTH - 1 - inset
+                    : x1;
+        if ((rows > 0) && ((left != *cx0) || (right != *cx1)))
+        { break; }
+        *cx0 = left;
+        *cx1 = right;
+        rows++;
+    } while (y++ < y1);
+    return rows;
+}
+#else
+static inline uint16_t gc9a01a_mask_rows(uint16_t y, uint16_t y1, uint16_t x0, uint16_t x1,
+                                         uint16_t *cx0, uint16_t *cx1) {
+    *cx0 = x0;
+    *cx1 = x1;
+    return y1 - y + 1;
+}
+#endif
 
-    params[0] = 0xFF;
-    gc9a01a_write_cmd(0x87);
-    gc9a01a_write_data_buf(params, 1);
+uint32_t gc9a01a_isqrt(uint32_t value) {
+    uint32_t root = 0, bit = 1UL << 30;
 
-    params[0] = 0xFF;
-    gc9a01a_write_cmd(0x8E);
-    gc9a01a_write_data_buf(params, 1);
+    // one result bit at a time
+    while (bit > value)
+    { bit >>= 2; }
+    while (bit != 0)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
 
-    params[0] = 0xFF;
-    gc9a01a_write_cmd(0x8F);
-    gc9a01a_write_data_buf(params, 1);
+uint8_t gc9a01a_round_inset(uint16_t y) {
+    if (y >= GC9A01A_TFTHEIGHT / 2)
+    { y = GC9A01A_TFTHEIGHT - 1 - y; }
+#if GC9A01A_ROUND_MASK
+    return round_inset[y];
+#else
+    // same half pixel computation as the mask table, for one row
+    uint32_t d = (GC9A01A_TFTHEIGHT - 1) - 2 * y;
+    uint32_t half = gc9a01a_isqrt((uint32_t)GC9A01A_TFTWIDTH * GC9A01A_TFTWIDTH - d * d);
 
-    params[0] = 0x0A;
-    gc9a01a_write_cmd(0x88);
-    gc9a01a_write_data_buf(params, 1);
+    return ((GC9A01A_TFTWIDTH - 1) - half + 1) / 2;
+#endif
+}
 
-    params[0] = 0x21;
-    gc9a01a_write_cmd(0x89);
-    gc9a01a_write_data_buf(params, 1);
+/*Pixel regions -------------------------------------------------*/
 
-    params[0] = 0x00;
-    gc9a01a_write_cmd(0x8A);
-    gc9a01a_write_data_buf(params, 1);
+/**
+ * Primitives write their pixels through a region: open a window, push
+ * pixels in row-major order, then close it. In the direct build the region
+ * is the panel address window, with GC9A01A_FRAMEBUFFER it is a rectangle of
+ * the offscreen target and the pixels are stored in bus byte order so that
+ * they can be sent as they are.
+ */
+#if GC9A01A_OFFSCREEN
+/**
+ * Memory the primitives render into, covering the panel area starting at
+ * (x, y).
+ */
+static struct
+{
+    uint16_t *pixels;
+    int16_t x, y;
+    uint16_t width, height;
+} target;
 
-    params[0] = 0x80;
-    gc9a01a_write_cmd(0x8B);
-    gc9a01a_write_data_buf(params, 1);
+/**
+ * Rectangle the primitives may draw into, and its intersection with the
+ * target that region writes are checked against.
+ */
+static struct
+{
+    int16_t x0, y0, x1, y1;
+} clip = {0, 0, GC9A01A_TFTWIDTH - 1, GC9A01A_TFTHEIGHT - 1}, view;
+
+static void gc9a01a_update_view(void) {
+    view.x0 = (clip.x0 > target.x) ? clip.x0 : target.x;
+    view.y0 = (clip.y0 > target.y) ? clip.y0 : target.y;
+    view.x1 = target.x + target.width - 1;
+    view.y1 = target.y + target.height - 1;
+    if (view.x1 > clip.x1)
+    { view.x1 = clip.x1; }
+    if (view.y1 > clip.y1)
+    { view.y1 = clip.y1; }
+}
 
-    params[0] = 0x01;
-    gc9a01a_write_cmd(0x8C);
-    gc9a01a_write_data_buf(params, 1);
+static struct
+{
+    uint16_t x0, x1;
+    uint16_t y0, y1;
+    uint16_t cursor_x, cursor_y;
+    uint32_t count;
+} region;
+
+static void gc9a01a_mark_dirty_area(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+
+static inline void gc9a01a_region_open(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    region.x0 = x0;
+    region.x1 = x1;
+    region.y0 = y0;
+    region.y1 = y1;
+    region.cursor_x = x0;
+    region.cursor_y = y0;
+    region.count = 0;
+}
 
-    params[0] = 0x03;
-    gc9a01a_write_cmd(0x8D);
-    gc9a01a_write_data_buf(params, 1);
+static inline void gc9a01a_region_next(void) {
+    if (region.cursor_x++ == region.x1)
+    {
+        region.cursor_x = region.x0;
+        region.cursor_y = (region.cursor_y == region.y1) ? region.y0 : region.cursor_y + 1;
+    }
+}
 
-    params[0] = 0x08;
-    params[1] = 0x09;
-    params[2] = 0x14;
-    params[3] = 0x08;
-    gc9a01a_write_cmd(GC9A01A_BLANKP_CTRL);
-    gc9a01a_write_data_buf(params, 4);
+static inline void gc9a01a_region_push(uint16_t color) {
+    int16_t cx = region.cursor_x;
+    int16_t cy = region.cursor_y;
 
-    params[0] = 0x00;
-    params[1] = 0x00;
-    gc9a01a_write_cmd(GC9A01A_DISPFN_CTRL);  ///< Display Function Control
-    gc9a01a_write_data_buf(params, 2);
+    if ((cx >= view.x0) && (cy >= view.y0) && (cx <= view.x1) && (cy <= view.y1))
+    { target.pixels[(cy - target.y) * target.width + cx - target.x] = gc9a01a_to_bus(color); }
+    region.count++;
+    gc9a01a_region_next();
+}
 
-    params[0] = 0x48;
-    gc9a01a_write_cmd(GC9A01A_MADCTL);  ///< Memory Access Control
+static void gc9a01a_region_fill(uint16_t color, uint32_t count) {
+    uint16_t bus_color = gc9a01a_to_bus(color);
+    uint32_t span;
+    int16_t a, b, cy;
+    uint16_t *row;
 
-    gc9a01a_write_data_buf(params, 1);
+    region.count += count;
+    while (count > 0)
+    {
+        span = region.x1 - region.cursor_x + 1;
+        if (span > count)
+        { span = count; }
+        cy = region.cursor_y;
+        a = (region.cursor_x > view.x0) ? region.cursor_x : view.x0;
+        b = region.cursor_x + span - 1;
+        if (b > view.x1)
+        { b = view.x1; }
+        if ((cy >= view.y0) && (cy <= view.y1))
+        {
+            row = &target.pixels[(cy - target.y) * target.width - target.x];
+            for (; a <= b; a++)
+            { row[a] = bus_color; }
+        }
+        count -= span;
+        region.cursor_x += span - 1;
+        gc9a01a_region_next();
+    }
+}
 
-    params[0] = 0x05;
-    gc9a01a_write_cmd(GC9A01A_PIXSET);  ///< Pixel Format Set
-    gc9a01a_write_data_buf(params, 1);
+static inline void gc9a01a_region_close(void) {
+    uint32_t width = region.x1 - region.x0 + 1;
+    int16_t x0 = region.x0, y0 = region.y0, x1, y1;
 
-    params[0] = 0x08;
-    params[1] = 0x08;
-    params[2] = 0x08;
-    params[3] = 0x08;
-    gc9a01a_write_cmd(0x90);
-    gc9a01a_write_data_buf(params, 4);
+    // only the pixels actually pushed are dirty, write_pixel opens the
+    // window up to the end of the row but sends a single pixel
+    if (region.count == 0)
+        return;
+    if (region.count < width)
+    {
+        x1 = region.x0 + region.count - 1;
+        y1 = region.y0;
+    } else
+    {
+        uint32_t rows = (region.count + width - 1) / width;
 
-    params[0] = 0x06;
-    gc9a01a_write_cmd(0xBD);
-    gc9a01a_write_data_buf(params, 1);
+        x1 = region.x1;
+        y1 = (region.y0 + rows - 1 > region.y1) ? region.y1 : region.y0 + rows - 1;
+    }
+    region.count = 0;
+
+    // nothing outside the clip rectangle was written
+    if (x0 < clip.x0)
+    { x0 = clip.x0; }
+    if (y0 < clip.y0)
+    { y0 = clip.y0; }
+    if (x1 > clip.x1)
+    { x1 = clip.x1; }
+    if (y1 > clip.y1)
+    { y1 = clip.y1; }
+    if ((x0 <= x1) && (y0 <= y1))
+    { gc9a01a_mark_dirty_area(x0, y0, x1, y1); }
+}
+#else
+/**
+ * The direct build draws on the whole panel.
+ */
+static const struct
+{
+    int16_t x0, y0, x1, y1;
+} clip = {0, 0, GC9A01A_TFTWIDTH - 1, GC9A01A_TFTHEIGHT - 1};
 
-    params[0] = 0x01;
-    gc9a01a_write_cmd(GC9A01A_TECTRL);
-    gc9a01a_write_data_buf(params, 1);
+static inline void gc9a01a_region_open(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    gc9a01a_set_address_window(x0, y0, x1, y1);
+}
 
-    params[0] = 0x00;
-    gc9a01a_write_cmd(0xBC);
-    gc9a01a_write_data_buf(params, 1);
+static inline void gc9a01a_region_push(uint16_t color) {
+    gc9a01a_tx_push_color(color);
+}
+
+static inline void gc9a01a_region_fill(uint16_t color, uint32_t count) {
+    gc9a01a_tx_write_color(color, count);
+}
+
+static inline void gc9a01a_region_close(void) {
+    gc9a01a_tx_flush();
+}
+#endif
+
+#if GC9A01A_OFFSCREEN
+#if GC9A01A_FRAME_DIFF
+static gc9a01a_diff_stats_t diff_stats;
+#define GC9A01A_DIFF_SENT(bytes) (diff_stats.bytes_sent += (bytes))
+#else
+#define GC9A01A_DIFF_SENT(bytes) ((void)0)
+#endif
+
+/**
+ * Send the rectangle [x0, x1] x [y0, y1] of a 240 pixel wide buffer whose
+ * first row is panel row origin_y, one window per group of rows sharing
+ * the same visible span.
+ */
+static void gc9a01a_send_block(const uint16_t *pixels, uint16_t origin_y, uint16_t x0,
+                               uint16_t y0, uint16_t x1, uint16_t y1) {
+    uint16_t y, row, rows, cx0, cx1;
+    uint32_t size;
+
+    for (y = y0; y <= y1; y += rows)
+    {
+        rows = gc9a01a_mask_rows(y, y1, x0, x1, &cx0, &cx1);
+        if (cx0 > cx1)
+        { continue; }
+        gc9a01a_set_address_window(cx0, y, cx1, y + rows - 1);
+        size = 2 * (cx1 - cx0 + 1);
+        GC9A01A_DIFF_SENT(size * rows);
+#if !USE_DMA
+        // whole rows are contiguous in the buffer, send them in one burst
+        if (size == 2 * GC9A01A_TFTWIDTH)
+        {
+            gc9a01a_send_data((const uint8_t *)&pixels[(y - origin_y) * GC9A01A_TFTWIDTH],
+                              size * rows);
+            gc9a01a_window_advance((size / 2) * rows);
+            continue;
+        }
+#endif
+        for (row = y; row < y + rows; row++)
+        {
+            gc9a01a_tx_push_bytes(
+                (const uint8_t *)&pixels[(row - origin_y) * GC9A01A_TFTWIDTH + cx0], size);
+        }
+        gc9a01a_tx_flush();
+    }
+}
+
+#if GC9A01A_FRAME_DIFF
+#define GC9A01A_DIFF_SEGMENTS \
+    ((GC9A01A_TFTWIDTH + GC9A01A_DIFF_SEGMENT - 1) / GC9A01A_DIFF_SEGMENT)
+#if GC9A01A_DIFF_SEGMENTS > 32
+#error "GC9A01A_DIFF_SEGMENT must split a row in at most 32 segments"
+#endif
+
+/**
+ * What the panel shows, kept per row segment: a hash of its pixels
+ * (GC9A01A_FRAME_DIFF 1) or the pixels themselves (GC9A01A_FRAME_DIFF 2).
+ * diff_known has one bit per segment whose hash or copy matches the panel.
+ */
+#if GC9A01A_FRAME_DIFF == 1
+static uint32_t diff_hash[GC9A01A_TFTHEIGHT][GC9A01A_DIFF_SEGMENTS];
+#else
+static uint16_t diff_prev[GC9A01A_TFTWIDTH * GC9A01A_TFTHEIGHT];
+#endif
+static uint32_t diff_known[GC9A01A_TFTHEIGHT];
+
+/**
+ * Compare the columns x0..x1 of one buffer row with what the panel shows,
+ * remember the new content and return the mask of changed segments. Only
+ * the columns that will be sent are recorded. A hash covers the whole
+ * segment, so a segment sent in part is forgotten until it is sent whole.
+ * The copy of GC9A01A_FRAME_DIFF 2 is compared and updated column by column.
+ */
+static uint32_t gc9a01a_diff_row(const uint16_t *line, uint16_t y, uint16_t x0, uint16_t x1) {
+    uint32_t changed = 0, bit;
+    uint16_t sx0, sx1, seg_x0, seg_x1;
+    uint8_t seg, whole;
+
+    for (seg = x0 / GC9A01A_DIFF_SEGMENT; seg <= x1 / GC9A01A_DIFF_SEGMENT; seg++)
+    {
+        bit = (uint32_t)1 << seg;
+        seg_x0 = seg * GC9A01A_DIFF_SEGMENT;
+        seg_x1 = seg_x0 + GC9A01A_DIFF_SEGMENT;
+        if (seg_x1 > GC9A01A_TFTWIDTH)
+        { seg_x1 = GC9A01A_TFTWIDTH; }
+        sx0 = (seg_x0 > x0) ? seg_x0 : x0;
+        sx1 = (seg_x1 < x1 + 1) ? seg_x1 : x1 + 1;
+        whole = (sx0 == seg_x0) && (sx1 == seg_x1);
+#if GC9A01A_FRAME_DIFF == 1
+        // FNV-1a over the segment, 0 is kept for segments never sent
+        uint32_t hash = 2166136261u;
+        uint16_t x;
+        for (x = seg_x0; x < seg_x1; x++)
+        { hash = (hash ^ line[x]) * 16777619u; }
+        hash |= 1;
+        if ((diff_known[y] & bit) && (diff_hash[y][seg] == hash))
+        { continue; }
+        // once part of the segment is sent, its hash matches neither side
+        if (!whole)
+        {
+            diff_known[y] &= ~bit;
+            changed |= bit;
+            continue;
+        }
+        diff_hash[y][seg] = hash;
+#else
+        uint16_t *prev = &diff_prev[y * GC9A01A_TFTWIDTH + sx0];
+        if ((diff_known[y] & bit) && (memcmp(prev, &line[sx0], 2 * (sx1 - sx0)) == 0))
+        { continue; }
+        memcpy(prev, &line[sx0], 2 * (sx1 - sx0));
+        if (!whole && !(diff_known[y] & bit))
+        {
+            changed |= bit;
+            continue;
+        }
+#endif
+        diff_known[y] |= bit;
+        changed |= bit;
+    }
+    return changed;
+}
+
+/**
+ * Send only the segments of the rectangle that differ from the panel. Rows
+ * with the same changed segments are grouped, and each run of adjacent
+ * changed segments gets its own window.
+ */
+static void gc9a01a_send_rect(const uint16_t *pixels, uint16_t origin_y, uint16_t x0, uint16_t y0,
+                              uint16_t x1, uint16_t y1) {
+    uint8_t first = x0 / GC9A01A_DIFF_SEGMENT;
+    uint8_t last = x1 / GC9A01A_DIFF_SEGMENT;
+    uint32_t changed, next = 0;
+    uint16_t y = y0, rows, rx0, rx1;
+    uint8_t seg, end;
+
+    diff_stats.bytes_total += 2 * (uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1);
+    changed = gc9a01a_diff_row(&pixels[(y - origin_y) * GC9A01A_TFTWIDTH], y, x0, x1);
+    while (y <= y1)
+    {
+        for (rows = 1; y + rows <= y1; rows++)
+        {
+            next = gc9a01a_diff_row(&pixels[(y + rows - origin_y) * GC9A01A_TFTWIDTH], y + rows,
+                                    x0, x1);
+            if (next != changed)
+            { break; }
+        }
+
+        for (seg = first; seg <= last; seg = end + 1)
+        {
+            end = seg;
+            if (!((changed >> seg) & 1))
+            { continue; }
+            while ((end < last) && ((changed >> (end + 1)) & 1))
+            { end++; }
+            rx0 = seg * GC9A01A_DIFF_SEGMENT;
+            rx1 = (end + 1) * GC9A01A_DIFF_SEGMENT - 1;
+            gc9a01a_send_block(pixels, origin_y, (rx0 > x0) ? rx0 : x0, y, (rx1 < x1) ? rx1 : x1,
+                               y + rows - 1);
+        }
+        y += rows;
+        changed = next;
+    }
+}
+
+static inline void gc9a01a_diff_begin(void) {
+    diff_stats.bytes_total = 0;
+    diff_stats.bytes_sent = 0;
+}
+
+static inline void gc9a01a_diff_end(void) {
+    diff_stats.bytes_saved = diff_stats.bytes_total - diff_stats.bytes_sent;
+}
+
+void gc9a01a_get_diff_stats(gc9a01a_diff_stats_t *stats) {
+    *stats = diff_stats;
+}
+#else
+static inline void gc9a01a_send_rect(const uint16_t *pixels, uint16_t origin_y, uint16_t x0,
+                                     uint16_t y0, uint16_t x1, uint16_t y1) {
+    gc9a01a_send_block(pixels, origin_y, x0, y0, x1, y1);
+}
+
+static inline void gc9a01a_diff_begin(void) {}
+static inline void gc9a01a_diff_end(void) {}
+
+void gc9a01a_get_diff_stats(gc9a01a_diff_stats_t *stats) {
+    stats->bytes_total = 0;
+    stats->bytes_sent = 0;
+    stats->bytes_saved = 0;
+}
+#endif
+#endif
+
+/*Dirty rectangles ----------------------------------------------*/
+
+#if GC9A01A_OFFSCREEN
+#define GC9A01A_DIRTY_MERGE_SLACK 64  ///< Clean pixels worth resending to save a window
+
+static inline uint32_t gc9a01a_rect_area(const gc9a01a_rect_t *r) {
+    return (uint32_t)(r->x1 - r->x0 + 1) * (r->y1 - r->y0 + 1);
+}
+
+static inline void gc9a01a_rect_union(gc9a01a_rect_t *out, const gc9a01a_rect_t *a,
+                                      const gc9a01a_rect_t *b) {
+    out->x0 = (a->x0 < b->x0) ? a->x0 : b->x0;
+    out->y0 = (a->y0 < b->y0) ? a->y0 : b->y0;
+    out->x1 = (a->x1 > b->x1) ? a->x1 : b->x1;
+    out->y1 = (a->y1 > b->y1) ? a->y1 : b->y1;
+}
+
+void gc9a01a_rect_merge(gc9a01a_rect_t *rects, uint8_t *count, uint8_t capacity,
+                        const gc9a01a_rect_t *rect) {
+    gc9a01a_rect_t add = *rect;
+    gc9a01a_rect_t merged;
+    uint32_t growth, best_growth = UINT32_MAX;
+    uint8_t i, best = 0;
+
+    // fold the rectangle into the list until nothing close remains
+    i = 0;
+    while (i < *count)
+    {
+        gc9a01a_rect_union(&merged, &rects[i], &add);
+        if (gc9a01a_rect_area(&merged) <=
+            gc9a01a_rect_area(&rects[i]) + gc9a01a_rect_area(&add) + GC9A01A_DIRTY_MERGE_SLACK)
+        {
+            add = merged;
+            rects[i] = rects[--(*count)];
+            i = 0;
+            continue;
+        }
+        i++;
+    }
+    if (*count < capacity)
+    {
+        rects[(*count)++] = add;
+        return;
+    }
+
+    // the list is full, grow the rectangle that costs the fewest clean pixels
+    for (i = 0; i < *count; i++)
+    {
+        gc9a01a_rect_union(&merged, &rects[i], &add);
+        growth = gc9a01a_rect_area(&merged) - gc9a01a_rect_area(&rects[i]);
+        if (growth < best_growth)
+        {
+            best_growth = growth;
+            best = i;
+        }
+    }
+    gc9a01a_rect_union(&rects[best], &rects[best], &add);
+}
+#endif
+
+/*Framebuffer ---------------------------------------------------*/
+
+#if GC9A01A_FRAMEBUFFER
+static uint16_t frame[GC9A01A_TFTWIDTH * GC9A01A_TFTHEIGHT];
+
+/**
+ * Rectangles touched since the last flush. Close rectangles are merged so
+ * that each flush only needs a few windows.
+ */
+static gc9a01a_rect_t dirty[GC9A01A_DIRTY_RECTS];
+static uint8_t dirty_count = 0;
+
+static void gc9a01a_mark_dirty_area(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    gc9a01a_rect_t rect = {x0, y0, x1, y1};
+
+    if (x1 >= GC9A01A_TFTWIDTH)
+    { rect.x1 = GC9A01A_TFTWIDTH - 1; }
+    if (y1 >= GC9A01A_TFTHEIGHT)
+    { rect.y1 = GC9A01A_TFTHEIGHT - 1; }
+    gc9a01a_rect_merge(dirty, &dirty_count, GC9A01A_DIRTY_RECTS, &rect);
+}
+
+void gc9a01a_flush(void) {
+    const gc9a01a_rect_t *r;
+    uint8_t i;
+
+    if (dirty_count == 0)
+        return;
+    gc9a01a_diff_begin();
+    gc9a01a_begin_transaction();
+    for (i = 0; i < dirty_count; i++)
+    {
+        r = &dirty[i];
+        gc9a01a_send_rect(frame, 0, r->x0, r->y0, r->x1, r->y1);
+    }
+    dirty_count = 0;
+    gc9a01a_end_transaction();
+    gc9a01a_diff_end();
+}
+
+uint16_t *gc9a01a_get_framebuffer(void) {
+    return frame;
+}
+
+void gc9a01a_mark_dirty(int16_t x, int16_t y, int16_t width, int16_t height) {
+    if (x < 0)
+    {
+        width += x;
+        x = 0;
+    }
+    if (y < 0)
+    {
+        height += y;
+        y = 0;
+    }
+    if ((width <= 0) || (height <= 0) || (x >= GC9A01A_TFTWIDTH) || (y >= GC9A01A_TFTHEIGHT))
+    { return; }
+    gc9a01a_mark_dirty_area(x, y, x + width - 1, y + height - 1);
+}
+
+void gc9a01a_set_background(uint16_t color) {
+    (void)color;
+}
+
+static void gc9a01a_offscreen_init(void) {
+    target.pixels = frame;
+    target.x = 0;
+    target.y = 0;
+    target.width = GC9A01A_TFTWIDTH;
+    target.height = GC9A01A_TFTHEIGHT;
+    gc9a01a_update_view();
+}
+#else
+#if GC9A01A_BAND_LINES
+/*Banded rendering ----------------------------------------------*/
+
+/**
+ * Draw calls are recorded and replayed by gc9a01a_flush() once per strip of
+ * GC9A01A_BAND_LINES rows. A first pass without any pixel store finds the
+ * rows reached by each record so that a strip only replays the records that
+ * cross it.
+ */
+enum
+{
+    GC9A01A_OP_WRITE_CHAR,
+    GC9A01A_OP_WRITE_STRING,
+    GC9A01A_OP_WRITE_PIXEL,
+    GC9A01A_OP_DRAW_IMAGE,
+    GC9A01A_OP_DRAW_LINE,
+    GC9A01A_OP_DRAW_VLINE,
+    GC9A01A_OP_DRAW_HLINE,
+    GC9A01A_OP_DRAW_RECTANGLE,
+    GC9A01A_OP_FILL_RECTANGLE,
+    GC9A01A_OP_DRAW_CIRCLE,
+    GC9A01A_OP_FILL_CIRCLE,
+    GC9A01A_OP_DRAW_ELLIPSE,
+    GC9A01A_OP_FILL_ELLIPSE,
+    GC9A01A_OP_DRAW_TRIANGLE,
+    GC9A01A_OP_FILL_TRIANGLE,
+    GC9A01A_OP_DRAW_ROUND_RECTANGLE,
+    GC9A01A_OP_DRAW_ROUND_CORNER,
+    GC9A01A_OP_FILL_ROUND_RECTANGLE,
+    GC9A01A_OP_FILL_ROUND_CORNER,
+    GC9A01A_OP_FILL_SCREEN,
+    GC9A01A_OP_EXTERNAL,
+    GC9A01A_OP_EXTERNAL_TEXT,
+};
+
+typedef struct
+{
+    uint8_t op;
+    int16_t y_min, y_max;  ///< Rows reached by the call, y_min > y_max when none
+    int16_t args[6];
+    uint16_t color, bgcolor;
+    const void *data;  ///< Image, or string copied into band_text
+    union
+    {
+        gc9a01a_replay_fn call;       ///< GC9A01A_OP_EXTERNAL
+        gc9a01a_text_replay_fn text;  ///< GC9A01A_OP_EXTERNAL_TEXT
+    } replay;                         ///< Draw call of another module
+    union
+    {
+        glcd_font_t glcd;
+        const void *external;  ///< Font of GC9A01A_OP_EXTERNAL_TEXT
+    } font;
+} gc9a01a_band_record_t;
+
+static uint16_t band[GC9A01A_BAND_LINES * GC9A01A_TFTWIDTH];
+static gc9a01a_band_record_t band_records[GC9A01A_BAND_RECORDS];
+static char band_text[GC9A01A_BAND_TEXT_SIZE];
+static uint16_t band_record_count = 0;
+static uint16_t band_text_used = 0;
+static uint16_t band_background = 0;
+static uint8_t band_replaying = 0;
+static gc9a01a_band_record_t *band_current;  ///< Record being measured by the first pass
+static uint16_t band_x0, band_y0, band_x1, band_y1;  ///< Pixels of the strip drawn so far
+
+static void gc9a01a_mark_dirty_area(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    if (band_current != NULL)
+    {
+        if ((int16_t)y0 < band_current->y_min)
+        { band_current->y_min = y0; }
+        if ((int16_t)y1 > band_current->y_max)
+        { band_current->y_max = y1; }
+        return;
+    }
+
+    // keep the bounding box of what was drawn inside the strip
+    if (y0 < target.y)
+    { y0 = target.y; }
+    if (y1 >= target.y + target.height)
+    { y1 = target.y + target.height - 1; }
+    if (x1 >= GC9A01A_TFTWIDTH)
+    { x1 = GC9A01A_TFTWIDTH - 1; }
+    if (y0 > y1)
+        return;
+    if (x0 < band_x0)
+    { band_x0 = x0; }
+    if (x1 > band_x1)
+    { band_x1 = x1; }
+    if (y0 < band_y0)
+    { band_y0 = y0; }
+    if (y1 > band_y1)
+    { band_y1 = y1; }
+}
+
+static void gc9a01a_band_replay(const gc9a01a_band_record_t *r) {
+    const int16_t *a = r->args;
+
+    switch (r->op)
+    {
+        case GC9A01A_OP_WRITE_CHAR:
+            gc9a01a_write_char(a[0], a[1], (char)a[2], r->font.glcd, r->color, r->bgcolor);
+            break;
+        case GC9A01A_OP_WRITE_STRING:
+            gc9a01a_write_string(a[0], a[1], r->data, r->font.glcd, r->color, r->bgcolor);
+            break;
+        case GC9A01A_OP_WRITE_PIXEL:
+            gc9a01a_write_pixel(a[0], a[1], r->color);
+            break;
+        case GC9A01A_OP_DRAW_IMAGE:
+            gc9a01a_draw_image(a[0], a[1], a[2], a[3], r->data);
+            break;
+        case GC9A01A_OP_DRAW_LINE:
+            gc9a01a_draw_line(a[0], a[1], a[2], a[3], r->color);
+            break;
+        case GC9A01A_OP_DRAW_VLINE:
+            gc9a01a_draw_fast_vertical_line(a[0], a[1], a[2], r->color);
+            break;
+        case GC9A01A_OP_DRAW_HLINE:
+            gc9a01a_draw_fast_horizental_line(a[0], a[1], a[2], r->color);
+            break;
+        case GC9A01A_OP_DRAW_RECTANGLE:
+            gc9a01a_draw_rectangle(a[0], a[1], a[2], a[3], r->color);
+            break;
+        case GC9A01A_OP_FILL_RECTANGLE:
+            gc9a01a_fill_rectangle(a[0], a[1], a[2], a[3], r->color);
+            break;
+        case GC9A01A_OP_DRAW_CIRCLE:
+            gc9a01a_draw_circle(a[0], a[1], a[2], r->color);
+            break;
+        case GC9A01A_OP_FILL_CIRCLE:
+            gc9a01a_fill_circle(a[0], a[1], a[2], r->color);
+            break;
+        case GC9A01A_OP_DRAW_ELLIPSE:
+            gc9a01a_draw_ellipse(a[0], a[1], a[2], a[3], r->color);
+            break;
+        case GC9A01A_OP_FILL_ELLIPSE:
+            gc9a01a_fill_ellipse(a[0], a[1], a[2], a[3], r->color);
+            break;
+        case GC9A01A_OP_DRAW_TRIANGLE:
+            gc9a01a_draw_triangle(a[0], a[1], a[2], a[3], a[4], a[5], r->color);
+            break;
+        case GC9A01A_OP_FILL_TRIANGLE:
+            gc9a01a_fill_triangle(a[0], a[1], a[2], a[3], a[4], a[5], r->color);
+            break;
+        case GC9A01A_OP_DRAW_ROUND_RECTANGLE:
+            gc9a01a_draw_round_rectangle(a[0], a[1], a[2], a[3], a[4], r->color);
+            break;
+        case GC9A01A_OP_DRAW_ROUND_CORNER:
+            gc9a01a_draw_round_corner(a[0], a[1], a[2], a[3], r->color);
+            break;
+        case GC9A01A_OP_FILL_ROUND_RECTANGLE:
+            gc9a01a_fill_round_rectangle(a[0], a[1], a[2], a[3], a[4], r->color);
+            break;
+        case GC9A01A_OP_FILL_ROUND_CORNER:
+            gc9a01a_fill_round_corner(a[0], a[1], a[2], a[3], a[4], r->color);
+            break;
+        case GC9A01A_OP_FILL_SCREEN:
+            gc9a01a_fill_screen(r->color);
+            break;
+        case GC9A01A_OP_EXTERNAL:
+            r->replay.call(a, r->color, r->data);
+            break;
+        case GC9A01A_OP_EXTERNAL_TEXT:
+            r->replay.text(a[0], a[1], r->data, r->font.external, r->color, r->bgcolor);
+            break;
+    }
+}
+
+/**
+ * Store a draw call for the next flush, flushing first when the record
+ * list is full. Returns the record so that text calls can add their font.
+ */
+static gc9a01a_band_record_t *gc9a01a_band_record(uint8_t op, const int16_t *args, uint8_t count,
+                                                  uint16_t color, const void *data) {
+    gc9a01a_band_record_t *r;
+    uint8_t i;
+
+    if (band_record_count == GC9A01A_BAND_RECORDS)
+    { gc9a01a_flush(); }
+    r = &band_records[band_record_count++];
+    r->op = op;
+    for (i = 0; i < count; i++)
+    { r->args[i] = args[i]; }
+    r->color = color;
+    r->data = data;
+    return r;
+}
+
+/**
+ * Copy a string into band_text, the caller's string may not outlive the
+ * call. Room for the record is made first so that no flush can drop the
+ * copy before it is recorded.
+ */
+static const char *gc9a01a_band_copy_text(const char *str) {
+    uint16_t size = strlen(str) + 1;
+    char *copy;
+
+    if ((band_record_count == GC9A01A_BAND_RECORDS) ||
+        (size > GC9A01A_BAND_TEXT_SIZE - band_text_used))
+    { gc9a01a_flush(); }
+    if (size > GC9A01A_BAND_TEXT_SIZE)
+    { size = GC9A01A_BAND_TEXT_SIZE; }
+    copy = &band_text[band_text_used];
+    memcpy(copy, str, size - 1);
+    copy[size - 1] = '\0';
+    band_text_used += size;
+    return copy;
+}
+
+static uint8_t gc9a01a_band_record_text(int16_t x, int16_t y, const char *str, glcd_font_t font,
+                                        uint16_t color, uint16_t bgcolor) {
+    const int16_t args[] = {x, y};
+    gc9a01a_band_record_t *r;
+
+    if (band_replaying)
+        return 0;
+    r = gc9a01a_band_record(GC9A01A_OP_WRITE_STRING, args, 2, color, gc9a01a_band_copy_text(str));
+    r->font.glcd = font;
+    r->bgcolor = bgcolor;
+    return 1;
+}
+
+uint8_t gc9a01a_record_call(gc9a01a_replay_fn replay, const int16_t *args, uint8_t count,
+                            uint16_t color, const void *data) {
+    if (band_replaying)
+        return 0;
+    gc9a01a_band_record(GC9A01A_OP_EXTERNAL, args, count, color, data)->replay.call = replay;
+    return 1;
+}
+
+uint8_t gc9a01a_record_text(gc9a01a_text_replay_fn replay, int16_t x, int16_t y, const char *str,
+                            const void *font, uint16_t color, uint16_t bgcolor) {
+    const int16_t args[] = {x, y};
+    gc9a01a_band_record_t *r;
+
+    if (band_replaying)
+        return 0;
+    r = gc9a01a_band_record(GC9A01A_OP_EXTERNAL_TEXT, args, 2, color, gc9a01a_band_copy_text(str));
+    r->replay.text = replay;
+    r->font.external = font;
+    r->bgcolor = bgcolor;
+    return 1;
+}
+
+#define GC9A01A_RECORD(op, color, data, ...)                                                 \
+    do                                                                                       \
+    {                                                                                        \
+        if (!band_replaying)                                                                 \
+        {                                                                                    \
+            const int16_t record_args[] = {__VA_ARGS__};                                     \
+            gc9a01a_band_record((op), record_args, sizeof(record_args) / sizeof(int16_t),   \
+                                (color), (data));                                            \
+            return;                                                                          \
+        }                                                                                    \
+    } while (0)
+
+void gc9a01a_flush(void) {
+    uint16_t i, y;
+    uint32_t k;
+
+    if (band_record_count == 0)
+        return;
+    band_replaying = 1;
+
+    // measure the rows of every record without storing pixels
+    target.height = 0;
+    gc9a01a_update_view();
+    for (i = 0; i < band_record_count; i++)
+    {
+        band_current = &band_records[i];
+        band_current->y_min = INT16_MAX;
+        band_current->y_max = -1;
+        gc9a01a_band_replay(band_current);
+    }
+    band_current = NULL;
+
+    gc9a01a_diff_begin();
+    gc9a01a_begin_transaction();
+    for (y = 0; y < GC9A01A_TFTHEIGHT; y += GC9A01A_BAND_LINES)
+    {
+        target.y = y;
+        target.height = GC9A01A_BAND_LINES;
+        if (y + target.height > GC9A01A_TFTHEIGHT)
+        { target.height = GC9A01A_TFTHEIGHT - y; }
+        gc9a01a_update_view();
+        if (view.y0 > view.y1)
+        { continue; }
+        band_x0 = UINT16_MAX;
+        band_y0 = UINT16_MAX;
+        band_x1 = 0;
+        band_y1 = 0;
+
+        for (k = 0; k < (uint32_t)target.height * GC9A01A_TFTWIDTH; k++)
+        { band[k] = gc9a01a_to_bus(band_background); }
+        for (i = 0; i < band_record_count; i++)
+        {
+            if ((band_records[i].y_min < y + target.height) && (band_records[i].y_max >= y))
+            { gc9a01a_band_replay(&band_records[i]); }
+        }
+#if GC9A01A_FRAME_DIFF
+        // each frame describes the whole clip rectangle, the comparison
+        // finds what actually changed
+        gc9a01a_send_rect(band, y, view.x0, view.y0, view.x1, view.y1);
+#else
+        if (band_x0 > band_x1)
+        { continue; }
+
+        // only the drawn part of the strip goes to the panel
+        gc9a01a_send_rect(band, y, band_x0, band_y0, band_x1, band_y1);
+#endif
+    }
+    gc9a01a_end_transaction();
+    gc9a01a_diff_end();
+    target.height = 0;
+    gc9a01a_update_view();
+
+    band_replaying = 0;
+    band_record_count = 0;
+    band_text_used = 0;
+}
+
+void gc9a01a_set_background(uint16_t color) {
+    band_background = color;
+}
+
+static void gc9a01a_offscreen_init(void) {
+    target.pixels = band;
+    target.x = 0;
+    target.y = 0;
+    target.width = GC9A01A_TFTWIDTH;
+    target.height = 0;
+    gc9a01a_update_view();
+}
+#else
+/**
+ * Color the blending primitives mix with, the panel content cannot be read
+ * back in the direct build.
+ */
+static uint16_t background = 0;
+
+void gc9a01a_flush(void) {
+    // pixels already went to the panel, only wait for the last DMA transfer
+    gc9a01a_wait_idle();
+}
+
+void gc9a01a_set_background(uint16_t color) {
+    background = color;
+}
+#endif
+
+uint16_t *gc9a01a_get_framebuffer(void) {
+    return NULL;
+}
+
+void gc9a01a_mark_dirty(int16_t x, int16_t y, int16_t width, int16_t height) {
+    (void)x;
+    (void)y;
+    (void)width;
+    (void)height;
+}
+#endif
+
+#if !GC9A01A_BAND_LINES
+#define GC9A01A_RECORD(op, color, data, ...) ((void)0)
+#endif
+
+void gc9a01a_invalidate(void) {
+#if GC9A01A_FRAME_DIFF
+    memset(diff_known, 0, sizeof(diff_known));
+#endif
+#if GC9A01A_FRAMEBUFFER
+    gc9a01a_mark_dirty_area(0, 0, GC9A01A_TFTWIDTH - 1, GC9A01A_TFTHEIGHT - 1);
+#endif
+}
+
+#if !GC9A01A_BAND_LINES
+uint8_t gc9a01a_record_call(gc9a01a_replay_fn replay, const int16_t *args, uint8_t count,
+                            uint16_t color, const void *data) {
+    (void)replay;
+    (void)args;
+    (void)count;
+    (void)color;
+    (void)data;
+    return 0;
+}
+
+uint8_t gc9a01a_record_text(gc9a01a_text_replay_fn replay, int16_t x, int16_t y, const char *str,
+                            const void *font, uint16_t color, uint16_t bgcolor) {
+    (void)replay;
+    (void)x;
+    (void)y;
+    (void)str;
+    (void)font;
+    (void)color;
+    (void)bgcolor;
+    return 0;
+}
+#endif
+
+#if GC9A01A_OFFSCREEN
+void gc9a01a_set_clip(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    clip.x0 = (x0 < 0) ? 0 : x0;
+    clip.y0 = (y0 < 0) ? 0 : y0;
+    clip.x1 = (x1 >= GC9A01A_TFTWIDTH) ? GC9A01A_TFTWIDTH - 1 : x1;
+    clip.y1 = (y1 >= GC9A01A_TFTHEIGHT) ? GC9A01A_TFTHEIGHT - 1 : y1;
+    gc9a01a_update_view();
+}
+
+void gc9a01a_reset_clip(void) {
+    gc9a01a_set_clip(0, 0, GC9A01A_TFTWIDTH - 1, GC9A01A_TFTHEIGHT - 1);
+}
+#endif
+
+void gc9a01a_region_begin(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    gc9a01a_begin_transaction();
+    gc9a01a_region_open(x0, y0, x1, y1);
+}
+
+void gc9a01a_region_write(const uint16_t *pixels, uint32_t count) {
+    while (count-- > 0)
+    { gc9a01a_region_push(*pixels++); }
+}
+
+void gc9a01a_region_write_bus(const uint8_t *data, uint32_t count) {
+#if GC9A01A_OFFSCREEN
+    for (; count > 0; count--, data += 2)
+    { gc9a01a_region_push((data[0] << 8) | data[1]); }
+#else
+    // already in the order the panel expects, copy as it is
+    gc9a01a_tx_push_bytes(data, 2 * count);
+#endif
+}
 
-    params[0] = 0x60;
-    params[1] = 0x01;
-    params[2] = 0x04;
-    gc9a01a_write_cmd(0xFF);
-    gc9a01a_write_data_buf(params, 3);
+void gc9a01a_region_send_bus(const uint8_t *data, uint32_t count) {
+#if GC9A01A_OFFSCREEN
+    gc9a01a_region_write_bus(data, count);
+#else
+    // what is pending goes first, then the block leaves from where it is
+    gc9a01a_tx_flush();
+    gc9a01a_send_data(data, 2 * count);
+    gc9a01a_window_advance(count);
+#endif
+}
 
-    params[0] = 0x14;
-    gc9a01a_write_cmd(GC9A01A_VREG1AVCTRL);  ///< Power Control 2
-    gc9a01a_write_data_buf(params, 1);
+void gc9a01a_region_repeat(uint16_t color, uint32_t count) {
+    gc9a01a_region_fill(color, count);
+}
 
-    params[0] = 0x14;
-    gc9a01a_write_cmd(GC9A01A_VREG1BVCTRL);  ///< Power Control 3
-    gc9a01a_write_data_buf(params, 1);
+void gc9a01a_region_blend(gc9a01a_blend_fn blend, const uint8_t *src, uint8_t size,
+                          uint32_t count, uint16_t color) {
+#if GC9A01A_OFFSCREEN
+    uint32_t span;
+    int16_t cy, a, b;
 
-    params[0] = 0x25;
-    gc9a01a_write_cmd(GC9A01A_VREG2AVCTRL);  ///< Power Control 4
-    gc9a01a_write_data_buf(params, 1);
+    // blend in place the part of each row that lies in the target
+    region.count += count;
+    while (count > 0)
+    {
+        span = region.x1 - region.cursor_x + 1;
+        if (span > count)
+        { span = count; }
+        cy = region.cursor_y;
+        a = (region.cursor_x > view.x0) ? region.cursor_x : view.x0;
+        b = region.cursor_x + span - 1;
+        if (b > view.x1)
+        { b = view.x1; }
+        if ((cy >= view.y0) && (cy <= view.y1) && (a <= b))
+        {
+            blend(&target.pixels[(cy - target.y) * target.width + a - target.x],
+                  src + (a - region.cursor_x) * size, b - a + 1, color);
+        }
+        src += span * size;
+        count -= span;
+        region.cursor_x += span - 1;
+        gc9a01a_region_next();
+    }
+#else
+    uint16_t out[32];
+    uint32_t chunk, i;
 
-    params[0] = 0x11;
-    gc9a01a_write_cmd(0xBE);
-    gc9a01a_write_data_buf(params, 1);
+    while (count > 0)
+    {
+        chunk = (count > 32) ? 32 : count;
+        for (i = 0; i < chunk; i++)
+        { out[i] = gc9a01a_to_bus(background); }
+        blend(out, src, chunk, color);
+        gc9a01a_tx_push_bytes((const uint8_t *)out, 2 * chunk);
+        src += chunk * size;
+        count -= chunk;
+    }
+#endif
+}
 
-    params[0] = 0x10;
-    params[1] = 0x0e;
-    gc9a01a_write_cmd(0xE1);
-    gc9a01a_write_data_buf(params, 2);
-
-    params[0] = 0x21;
-    params[1] = 0x0c;
-    params[2] = 0x02;
-    gc9a01a_write_cmd(0xDF);
-    gc9a01a_write_data_buf(params, 3);
-
-    params[0] = 0x45;
-    params[1] = 0x09;
-    params[2] = 0x08;
-    params[3] = 0x08;
-    params[4] = 0x26;
-    params[5] = 0x2A;
-    gc9a01a_write_cmd(GC9A01A_SET_GAMMA_1);  ///< Set gamma 1
-    gc9a01a_write_data_buf(params, 6);
-
-    params[0] = 0x43;
-    params[1] = 0x70;
-    params[2] = 0x72;
-    params[3] = 0x36;
-    params[4] = 0x37;
-    params[5] = 0x6F;
-    gc9a01a_write_cmd(GC9A01A_SET_GAMMA_2);  ///< Set gamma 2
-    gc9a01a_write_data_buf(params, 6);
-
-    params[0] = 0x45;
-    params[1] = 0x09;
-    params[2] = 0x08;
-    params[3] = 0x08;
-    params[4] = 0x26;
-    params[5] = 0x2A;
-    gc9a01a_write_cmd(GC9A01A_SET_GAMMA_3);  ///< Set gamma 3
-    gc9a01a_write_data_buf(params, 6);
-
-    params[0] = 0x43;
-    params[1] = 0x70;
-    params[2] = 0x72;
-    params[3] = 0x36;
-    params[4] = 0x37;
-    params[5] = 0x6F;
-    gc9a01a_write_cmd(GC9A01A_SET_GAMMA_4);  ///< Set gamma 4
-    gc9a01a_write_data_buf(params, 6);
-
-    params[0] = 0x1B;
-    params[1] = 0x0B;
-    gc9a01a_write_cmd(0xED);
-    gc9a01a_write_data_buf(params, 2);
-
-    params[0] = 0x77;
-    gc9a01a_write_cmd(0xAE);
-    gc9a01a_write_data_buf(params, 1);
+void gc9a01a_region_end(void) {
+    gc9a01a_region_close();
+    gc9a01a_end_transaction();
+}
 
-    params[0] = 0x63;
-    gc9a01a_write_cmd(0xCD);
-    gc9a01a_write_data_buf(params, 1);
+#if !GC9A01A_OFFSCREEN
+void gc9a01a_get_diff_stats(gc9a01a_diff_stats_t *stats) {
+    stats->bytes_total = 0;
+    stats->bytes_sent = 0;
+    stats->bytes_saved = 0;
+}
+#endif
 
-    params[0] = 0x07;
-    params[1] = 0x07;
-    params[2] = 0x04;
-    params[3] = 0x0E;
-    params[4] = 0x0F;
-    params[5] = 0x09;
-    params[6] = 0x07;
-    params[7] = 0x08;
-    params[8] = 0x03;
-    gc9a01a_write_cmd(0x70);
-    gc9a01a_write_data_buf(params, 9);
-
-    params[0] = 0x34;
-    gc9a01a_write_cmd(GC9A01A_FRAME_RATE);  ///< Frame rate control
-    gc9a01a_write_data_buf(params, 1);
+/**
+ * Power-on register sequence of the usual 240x240 round GC9A01A module,
+ * see GC9A01A_INIT_DELAY for the encoding.
+ */
+const uint8_t gc9a01a_init_sequence_default[] = {
+    GC9A01A_INREG_ON_1, 0,  // Inter register enable 1
+    GC9A01A_INREG_ON_2, 0,  // Inter register enable 2
+    0xEB, 1, 0x14,
+    0x84, 1, 0x60,
+    0x85, 1, 0xFF,
+    0x86, 1, 0xFF,
+    0x87, 1, 0xFF,
+    0x8E, 1, 0xFF,
+    0x8F, 1, 0xFF,
+    0x88, 1, 0x0A,
+    0x89, 1, 0x21,
+    0x8A, 1, 0x00,
+    0x8B, 1, 0x80,
+    0x8C, 1, 0x01,
+    0x8D, 1, 0x03,
+    GC9A01A_BLANKP_CTRL, 4, 0x08, 0x09, 0x14, 0x08,
+    GC9A01A_DISPFN_CTRL, 2, 0x00, 0x00,  // Display Function Control
+    GC9A01A_MADCTL, 1, 0x48,  // Memory Access Control
+    GC9A01A_PIXSET, 1, 0x05,  // Pixel Format Set
+    0x90, 4, 0x08, 0x08, 0x08, 0x08,
+    0xBD, 1, 0x06,
+    GC9A01A_TECTRL, 1, 0x01,
+    0xBC, 1, 0x00,
+    0xFF, 3, 0x60, 0x01, 0x04,
+    GC9A01A_VREG1AVCTRL, 1, 0x14,  // Power Control 2
+    GC9A01A_VREG1BVCTRL, 1, 0x14,  // Power Control 3
+    GC9A01A_VREG2AVCTRL, 1, 0x25,  // Power Control 4
+    0xBE, 1, 0x11,
+    0xE1, 2, 0x10, 0x0E,
+    0xDF, 3, 0x21, 0x0C, 0x02,
+    GC9A01A_SET_GAMMA_1, 6, 0x45, 0x09, 0x08, 0x08, 0x26, 0x2A,  // Set gamma 1
+    GC9A01A_SET_GAMMA_2, 6, 0x43, 0x70, 0x72, 0x36, 0x37, 0x6F,  // Set gamma 2
+    GC9A01A_SET_GAMMA_3, 6, 0x45, 0x09, 0x08, 0x08, 0x26, 0x2A,  // Set gamma 3
+    GC9A01A_SET_GAMMA_4, 6, 0x43, 0x70, 0x72, 0x36, 0x37, 0x6F,  // Set gamma 4
+    0xED, 2, 0x1B, 0x0B,
+    0xAE, 1, 0x77,
+    0xCD, 1, 0x63,
+    0x70, 9, 0x07, 0x07, 0x04, 0x0E, 0x0F, 0x09, 0x07, 0x08, 0x03,
+    GC9A01A_FRAME_RATE, 1, 0x34,  // Frame rate control
+    0x62, 12, 0x18, 0x0D, 0x71, 0xED, 0x70, 0x70, 0x18, 0x0F, 0x71, 0xEF, 0x70, 0x70,
+    0x63, 12, 0x18, 0x11, 0x71, 0xF1, 0x70, 0x70, 0x18, 0x13, 0x71, 0xF3, 0x70, 0x70,
+    0x64, 7, 0x28, 0x29, 0xF1, 0x01, 0xF1, 0x00, 0x07,
+    0x66, 10, 0x3C, 0x00, 0xCD, 0x67, 0x45, 0x45, 0x10, 0x00, 0x00, 0x00,
+    0x67, 10, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x01, 0x54, 0x10, 0x32, 0x98,
+    0x74, 7, 0x10, 0x85, 0x80, 0x00, 0x00, 0x4E, 0x00,
+    0x98, 2, 0x3E, 0x07,
+    0x99, 2, 0x3E, 0x07,
+    GC9A01A_TELON, 1, 0x00,  // Tearing Effect Line ON
+    GC9A01A_DISP_IN_ON, 0,  // Display Inversion ON
+    GC9A01A_SLPOUT, GC9A01A_INIT_DELAY | 0, 120,  // Sleep Out
+    GC9A01A_DISP_ON, GC9A01A_INIT_DELAY | 0, 20,  // Display ON
+    GC9A01A_INIT_END,
+};
+
+static const uint8_t *init_sequence = gc9a01a_init_sequence_default;
+
+void gc9a01a_set_init_sequence(const uint8_t *sequence) {
+    init_sequence = (sequence != NULL) ? sequence : gc9a01a_init_sequence_default;
+}
 
-    params[0] = 0x18;
-    params[1] = 0x0D;
-    params[2] = 0x71;
-    params[3] = 0xED;
-    params[4] = 0x70;
-    params[5] = 0x70;
-    params[6] = 0x18;
-    params[7] = 0x0F;
-    params[8] = 0x71;
-    params[9] = 0xEF;
-    params[10] = 0x70;
-    params[11] = 0x70;
-    gc9a01a_write_cmd(0x62);
-    gc9a01a_write_data_buf(params, 12);
-
-    params[0] = 0x18;
-    params[1] = 0x11;
-    params[2] = 0x71;
-    params[3] = 0xF1;
-    params[4] = 0x70;
-    params[5] = 0x70;
-    params[6] = 0x18;
-    params[7] = 0x13;
-    params[8] = 0x71;
-    params[9] = 0xF3;
-    params[10] = 0x70;
-    params[11] = 0x70;
-    gc9a01a_write_cmd(0x63);
-    gc9a01a_write_data_buf(params, 12);
-
-    params[0] = 0x28;
-    params[1] = 0x29;
-    params[2] = 0xF1;
-    params[3] = 0x01;
-    params[4] = 0xF1;
-    params[5] = 0x00;
-    params[6] = 0x07;
-    gc9a01a_write_cmd(0x64);
-    gc9a01a_write_data_buf(params, 7);
-
-    params[0] = 0x3C;
-    params[1] = 0x00;
-    params[2] = 0xCD;
-    params[3] = 0x67;
-    params[4] = 0x45;
-    params[5] = 0x45;
-    params[6] = 0x10;
-    params[7] = 0x00;
-    params[8] = 0x00;
-    params[9] = 0x00;
-    gc9a01a_write_cmd(0x66);
-    gc9a01a_write_data_buf(params, 10);
-
-    params[0] = 0x00;
-    params[1] = 0x3C;
-    params[2] = 0x00;
-    params[3] = 0x00;
-    params[4] = 0x00;
-    params[5] = 0x01;
-    params[6] = 0x54;
-    params[7] = 0x10;
-    params[8] = 0x32;
-    params[9] = 0x98;
-    gc9a01a_write_cmd(0x67);
-    gc9a01a_write_data_buf(params, 10);
-
-    params[0] = 0x10;
-    params[1] = 0x85;
-    params[2] = 0x80;
-    params[3] = 0x00;
-    params[4] = 0x00;
-    params[5] = 0x4E;
-    params[6] = 0x00;
-    gc9a01a_write_cmd(0x74);
-    gc9a01a_write_data_buf(params, 7);
-
-    params[0] = 0x3E;
-    params[1] = 0x07;
-    gc9a01a_write_cmd(0x98);
-    gc9a01a_write_data_buf(params, 2);
-
-    params[0] = 0x3E;
-    params[1] = 0x07;
-    gc9a01a_write_cmd(0x99);
-    gc9a01a_write_data_buf(params, 2);
-
-    params[0] = 0x00;
-    gc9a01a_write_cmd(GC9A01A_TELON);  ///< Tearing Effect Line ON
-    gc9a01a_write_data_buf(params, 1);
+void gc9a01a_configure() {
+    const uint8_t *p = init_sequence;
+    uint8_t length;
 
-    gc9a01a_write_cmd(GC9A01A_DISP_IN_ON);  ///< Display Inversion ON
-    HAL_Delay(120);
-    gc9a01a_write_cmd(GC9A01A_SLPOUT);  ///< Sleep Out
-    HAL_Delay(120);
-    gc9a01a_write_cmd(GC9A01A_DISP_ON);  ///< Display ON
-    HAL_Delay(20);
+    gc9a01a_window_invalidate();
+    gc9a01a_begin_transaction();
+    while (p[1] != 0xFF)
+    {
+        length = p[1] & ~GC9A01A_INIT_DELAY;
+        gc9a01a_send_cmd(p[0]);
+        if (length > 0)
+        { gc9a01a_send_data(&p[2], length); }
+        if (p[1] & GC9A01A_INIT_DELAY)
+        {
+            bus->delay_ms(p[2 + length]);
+            p++;
+        }
+        p += 2 + length;
+    }
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_set_orientation(uint8_t orientation) {
+    gc9a01a_begin_transaction();
     uint8_t params[4] = {0x00, 0x00, 0x00, 0xf0};
     gc9a01a_write_cmd(GC9A01A_CASET);
     gc9a01a_write_data_buf(params, 4);
@@ -415,55 +1654,171 @@ void gc9a01a_set_orientation(uint8_t orientation) {
 
     gc9a01a_write_cmd(GC9A01A_MADCTL);
     gc9a01a_write_data_buf(params, 1);
+    gc9a01a_end_transaction();
+    // the panel content is now read back in another direction
+    gc9a01a_invalidate();
 }
 
 void gc9a01a_init(void) {
+#if GC9A01A_ROUND_MASK
+    gc9a01a_mask_init();
+#endif
+#if GC9A01A_OFFSCREEN
+    gc9a01a_offscreen_init();
+#endif
     gc9a01a_hw_reset();
     gc9a01a_configure();
     gc9a01a_set_orientation(LANDSCAPE);
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
 }
 
-void gc9a01a_write_char(uint16_t x, uint16_t y, char ch, glcd_font_t font, uint16_t color,
-                        uint16_t bgcolor) {
-    uint32_t i, j, b;
+static inline uint32_t gc9a01a_glyph_offset(char ch, glcd_font_t font) {
+    // characters outside the font table are drawn as a space
+    if ((ch < 32) || (ch > 126))
+    { ch = ' '; }
+    return (uint32_t)(ch - 32) * font.height;
+}
+
+/**
+ * Row i of a glyph, left pixel in the most significant bit. A packed row
+ * spans at most 3 bytes of the bitstream.
+ */
+static inline uint16_t gc9a01a_glyph_row(char ch, uint8_t i, glcd_font_t font) {
+    uint32_t pos, bits;
+    const uint8_t *p;
+    uint8_t end;
+
+    if (font.bits == NULL)
+        return font.data[gc9a01a_glyph_offset(ch, font) + i];
+    pos = (gc9a01a_glyph_offset(ch, font) + i) * font.width;
+    p = &font.bits[pos >> 3];
+    end = (pos & 7) + font.width;
+    bits = (uint32_t)p[0] << 16;
+    if (end > 8)
+    { bits |= (uint32_t)p[1] << 8; }
+    if (end > 16)
+    { bits |= p[2]; }
+    return ((bits << (pos & 7)) >> 8) & (0xFFFF << (16 - font.width));
+}
 
-    gc9a01a_set_address_window(x, y, x + font.width - 1, y + font.width - 1);
+/**
+ * Identifies a font in the glyph cache.
+ */
+static inline const void *gc9a01a_glyph_key(glcd_font_t font) {
+    return (font.bits != NULL) ? (const void *)font.bits : (const void *)font.data;
+}
+
+/**
+ * Expand a run of glyphs sharing the same text row into the transmit buffer,
+ * one pixel row at a time, so that the whole run fits in a single address
+ * window of (count * font.width) x font.height pixels.
+ */
+static void gc9a01a_write_glyph_run(const char *str, uint16_t count, glcd_font_t font,
+                                    uint16_t color, uint16_t bgcolor) {
+    uint32_t i, j, b;
+    uint16_t k;
 
     for (i = 0; i < font.height; i++)
     {
-        b = font.data[(ch - 32) * font.height + i];
-        for (j = 0; j < font.width; j++)
+        for (k = 0; k < count; k++)
         {
-            if ((b << j) & 0x8000)
-            {
-                uint8_t data[] = {color >> 8, color & 0xFF};
-                gc9a01a_write_data_buf(data, sizeof(data));
-            } else
-            {
-                uint8_t data[] = {bgcolor >> 8, bgcolor & 0xFF};
-                gc9a01a_write_data_buf(data, sizeof(data));
-            }
+            b = gc9a01a_glyph_row(str[k], i, font);
+            for (j = 0; j < font.width; j++)
+            { gc9a01a_region_push(((b << j) & 0x8000) ? color : bgcolor); }
         }
     }
-#if USE_DMA
-    while (tx_busy)
-        ;
+    gc9a01a_region_close();
+}
+
+/**
+ * Expand a glyph for the glyph cache.
+ */
+static void gc9a01a_glyph_render(uint16_t *pixels, const void *data, uint32_t code,
+                                 uint16_t color, uint16_t bgcolor) {
+    const glcd_font_t *font = data;
+    const uint16_t fg = gc9a01a_to_bus(color), bg = gc9a01a_to_bus(bgcolor);
+    uint32_t i, j, b;
+
+    for (i = 0; i < font->height; i++)
+    {
+        b = gc9a01a_glyph_row((char)code, i, *font);
+        for (j = 0; j < font->width; j++)
+        { *pixels++ = ((b << j) & 0x8000) ? fg : bg; }
+    }
+}
+
+/**
+ * Send a run of glyphs through the glyph cache, returns 0 when it is
+ * disabled or the glyphs do not fit in a slot.
+ */
+static uint8_t gc9a01a_write_cached_run(const char *str, uint8_t count, glcd_font_t font,
+                                        uint16_t color, uint16_t bgcolor) {
+    const uint8_t *glyphs[GC9A01A_GLYPH_RUN];
+    uint8_t widths[GC9A01A_GLYPH_RUN];
+    uint8_t k;
+
+    for (k = 0; k < count; k++)
+    {
+        glyphs[k] = gc9a01a_glyph_cache_get(gc9a01a_glyph_key(font), (uint8_t)str[k], color,
+                                            bgcolor, font.width * font.height,
+                                            gc9a01a_glyph_render, &font);
+        if (glyphs[k] == NULL)
+            return 0;
+        widths[k] = font.width;
+    }
+    gc9a01a_glyph_cache_write_run(glyphs, widths, count, font.height);
+    gc9a01a_region_close();
+    return 1;
+}
+
+void gc9a01a_write_char(uint16_t x, uint16_t y, char ch, glcd_font_t font, uint16_t color,
+                        uint16_t bgcolor) {
+#if GC9A01A_BAND_LINES
+    if (!band_replaying)
+    {
+        const int16_t args[] = {x, y, ch};
+        gc9a01a_band_record_t *r = gc9a01a_band_record(GC9A01A_OP_WRITE_CHAR, args, 3, color, NULL);
+        r->font.glcd = font;
+        r->bgcolor = bgcolor;
+        return;
+    }
 #endif
+    const uint8_t *cached = gc9a01a_glyph_cache_get(gc9a01a_glyph_key(font), (uint8_t)ch, color,
+                                                    bgcolor, font.width * font.height,
+                                                    gc9a01a_glyph_render, &font);
+
+    gc9a01a_begin_transaction();
+    gc9a01a_region_open(x, y, x + font.width - 1, y + font.height - 1);
+    if (cached != NULL)
+    {
+        // a cached glyph is a single transfer
+        gc9a01a_region_send_bus(cached, font.width * font.height);
+        gc9a01a_region_close();
+    } else
+    {
+        gc9a01a_write_glyph_run(&ch, 1, font, color, bgcolor);
+    }
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_write_string(int16_t x, int16_t y, const char *str, glcd_font_t font, uint16_t color,
                           uint16_t background_color) {
+#if GC9A01A_BAND_LINES
+    if (gc9a01a_band_record_text(x, y, str, font, color, background_color))
+        return;
+#endif
+    gc9a01a_begin_transaction();
+    uint16_t run, cached_run = gc9a01a_glyph_cache_slots();
+
+    // a run must not evict its own glyphs from the cache
+    if (cached_run > GC9A01A_GLYPH_RUN)
+    { cached_run = GC9A01A_GLYPH_RUN; }
     while (*str)
     {
-        if (x + font.width >= GC9A01A_TFTWIDTH)
+        if (x + font.width > GC9A01A_TFTWIDTH)
         {
             x = 0;
             y += font.height;
-            if (y + font.height >= GC9A01A_TFTHEIGHT)
+            if (y + font.height > GC9A01A_TFTHEIGHT)
             { break; }
 
             // skip
@@ -474,57 +1829,121 @@ void gc9a01a_write_string(int16_t x, int16_t y, const char *str, glcd_font_t fon
             }
         }
 
-        gc9a01a_write_char(x, y, *str, font, color, background_color);
-        x += font.width;
-        str++;
+        // batch every character that still fits on this row into one window
+        run = 0;
+        while (str[run] && (x + (run + 1) * font.width <= GC9A01A_TFTWIDTH))
+        { run++; }
+        if (cached_run && (run > cached_run))
+        { run = cached_run; }
+
+        gc9a01a_region_open(x, y, x + run * font.width - 1, y + font.height - 1);
+        if (!cached_run || !gc9a01a_write_cached_run(str, run, font, color, background_color))
+        { gc9a01a_write_glyph_run(str, run, font, color, background_color); }
+        x += run * font.width;
+        str += run;
     }
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_write_pixel(int16_t x, int16_t y, uint16_t color) {
-    if ((x >= GC9A01A_TFTWIDTH) || (y >= GC9A01A_TFTHEIGHT))
+    GC9A01A_RECORD(GC9A01A_OP_WRITE_PIXEL, color, NULL, x, y);
+    if ((x < 0) || (y < 0) || (x >= GC9A01A_TFTWIDTH) || (y >= GC9A01A_TFTHEIGHT))
         return;
 
-    gc9a01a_set_address_window(x, y, x + 1, y + 1);
-    uint8_t data[] = {color >> 8, color & 0xFF};
-    gc9a01a_write_data_buf(data, sizeof(data));
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    gc9a01a_begin_transaction();
+    // open the window up to the end of the row so that a pixel drawn right
+    // after this one only costs a Write Memory Continue
+    gc9a01a_region_open(x, y, GC9A01A_TFTWIDTH - 1, y);
+    gc9a01a_region_push(color);
+    gc9a01a_region_close();
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_draw_image(int16_t x, int16_t y, int16_t width, int16_t height,
                         const uint16_t *image) {
-    if ((x >= GC9A01A_TFTWIDTH) || (y >= GC9A01A_TFTWIDTH))
+    GC9A01A_RECORD(GC9A01A_OP_DRAW_IMAGE, 0, image, x, y, width, height);
+    int16_t stride = width;
+
+    // clip to the drawable area, rows of the image keep their original stride
+    if (x < clip.x0)
+    {
+        image += clip.x0 - x;
+        width -= clip.x0 - x;
+        x = clip.x0;
+    }
+    if (y < clip.y0)
+    {
+        image += (int32_t)(clip.y0 - y) * stride;
+        height -= clip.y0 - y;
+        y = clip.y0;
+    }
+    if ((x + width) > clip.x1 + 1)
+    { width = clip.x1 + 1 - x; }
+    if ((y + height) > clip.y1 + 1)
+    { height = clip.y1 + 1 - y; }
+    if ((width <= 0) || (height <= 0))
     { return; }
-    if ((x + width - 1) >= GC9A01A_TFTWIDTH)
-    { width = GC9A01A_TFTWIDTH - x; }
-    if ((y + height - 1) >= GC9A01A_TFTHEIGHT)
-    { height = GC9A01A_TFTHEIGHT - x; }
 
-    gc9a01a_set_address_window(x, y, x + width - 1, y + height - 1);
+    uint16_t row, rows, cx0, cx1, i;
+    const uint16_t *line;
 
-    for (uint16_t i = 0; i < (width * height); i++)
+    gc9a01a_begin_transaction();
+    for (row = y; row < y + height; row += rows)
     {
-        uint8_t color[] = {(image[i] >> 8) & 0xFF, image[i] & 0xFF};
-        gc9a01a_write_data_buf(color, sizeof(color));
+        rows = gc9a01a_mask_rows(row, y + height - 1, x, x + width - 1, &cx0, &cx1);
+        if (cx0 > cx1)
+        { continue; }
+        gc9a01a_region_open(cx0, row, cx1, row + rows - 1);
+        for (line = &image[(int32_t)(row - y) * stride + (cx0 - x)]; rows > 0; rows--, row++)
+        {
+            for (i = 0; i <= cx1 - cx0; i++)
+            { gc9a01a_region_push(line[i]); }
+            line += stride;
+        }
+        gc9a01a_region_close();
     }
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    gc9a01a_end_transaction();
+}
+
+/**
+ * Send a run of pixels sharing the same minor coordinate of a line as one
+ * span, a lone pixel keeps the cheaper open-ended pixel window.
+ */
+static void gc9a01a_draw_line_run(uint8_t steep, int16_t major, int16_t minor, int16_t length,
+                                  uint16_t color) {
+    if (length == 1)
+    {
+        if (steep)
+        {
+            gc9a01a_write_pixel(minor, major, color);
+        } else
+        { gc9a01a_write_pixel(major, minor, color); }
+    } else if (steep)
+    {
+        gc9a01a_draw_fast_vertical_line(minor, major, length, color);
+    } else
+    { gc9a01a_draw_fast_horizental_line(major, minor, length, color); }
 }
 
 void gc9a01a_draw_line(int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_1, uint16_t color) {
+    GC9A01A_RECORD(GC9A01A_OP_DRAW_LINE, color, NULL, x_0, y_0, x_1, y_1);
+    if (x_0 == x_1)
+    {
+        gc9a01a_draw_fast_vertical_line(x_0, (y_0 < y_1) ? y_0 : y_1, abs(y_1 - y_0) + 1, color);
+        return;
+    }
+    if (y_0 == y_1)
+    {
+        gc9a01a_draw_fast_horizental_line((x_0 < x_1) ? x_0 : x_1, y_0, abs(x_1 - x_0) + 1, color);
+        return;
+    }
+
+    gc9a01a_begin_transaction();
     int16_t steep = abs(y_1 - y_0) > abs(x_1 - x_0);
     if (steep)
     {
-        swap_int16_t(&x_0, &x_1);
-        swap_int16_t(&y_0, &y_1);
+        swap_int16_t(&x_0, &y_0);
+        swap_int16_t(&x_1, &y_1);
     }
 
     if (x_0 > x_1)
@@ -546,65 +1965,98 @@ void gc9a01a_draw_line(int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_1, uint1
     } else
     { ystep = -1; }
 
-    for (; x_0 > x_1; x_0++)
+    // collect the pixels of each major axis run and send them as one span
+    int16_t run_start = x_0;
+    for (; x_0 <= x_1; x_0++)
     {
-        if (steep)
-        {
-            gc9a01a_write_pixel(y_0, x_0, color);
-        } else
-        { gc9a01a_write_pixel(x_0, y_0, color); }
         err -= dy;
+        if ((err < 0) || (x_0 == x_1))
+        {
+            gc9a01a_draw_line_run(steep, run_start, y_0, x_0 - run_start + 1, color);
+            run_start = x_0 + 1;
+        }
         if (err < 0)
         {
             y_0 += ystep;
             err += dx;
         }
     }
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_draw_fast_vertical_line(int16_t x, int16_t y, int16_t height, uint16_t color) {
-    gc9a01a_draw_line(x, y, x, y + height - 1, color);
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    GC9A01A_RECORD(GC9A01A_OP_DRAW_VLINE, color, NULL, x, y, height);
+    // a negative height grows the line upwards
+    if (height < 0)
+    {
+        y += height + 1;
+        height = -height;
+    }
+    gc9a01a_fill_rectangle(x, y, 1, height, color);
 }
 
 void gc9a01a_draw_fast_horizental_line(int16_t x, int16_t y, int16_t width, uint16_t color) {
-    gc9a01a_draw_line(x, y, x + width - 1, y, color);
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    GC9A01A_RECORD(GC9A01A_OP_DRAW_HLINE, color, NULL, x, y, width);
+    // a negative width grows the line to the left
+    if (width < 0)
+    {
+        x += width + 1;
+        width = -width;
+    }
+    gc9a01a_fill_rectangle(x, y, width, 1, color);
 }
 
 void gc9a01a_draw_rectangle(int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color) {
+    GC9A01A_RECORD(GC9A01A_OP_DRAW_RECTANGLE, color, NULL, x, y, width, height);
+    gc9a01a_begin_transaction();
     gc9a01a_draw_fast_vertical_line(x, y, height, color);
     gc9a01a_draw_fast_horizental_line(x, y, width, color);
     gc9a01a_draw_fast_vertical_line(x + width - 1, y, height, color);
     gc9a01a_draw_fast_horizental_line(x, y + height - 1, width, color);
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_fill_rectangle(int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color) {
-    for (int16_t i = (y + 1); i < height; i++)
-    { gc9a01a_draw_fast_horizental_line(x + 1, i, width - 1, color); }
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    GC9A01A_RECORD(GC9A01A_OP_FILL_RECTANGLE, color, NULL, x, y, width, height);
+    // clip to the drawable area, a single window then covers the whole rectangle
+    if (x < clip.x0)
+    {
+        width -= clip.x0 - x;
+        x = clip.x0;
+    }
+    if (y < clip.y0)
+    {
+        height -= clip.y0 - y;
+        y = clip.y0;
+    }
+    if ((x + width) > clip.x1 + 1)
+    { width = clip.x1 + 1 - x; }
+    if ((y + height) > clip.y1 + 1)
+    { height = clip.y1 + 1 - y; }
+    if ((width <= 0) || (height <= 0))
+    { return; }
+
+    uint16_t row, rows, cx0, cx1;
+
+    gc9a01a_begin_transaction();
+    for (row = y; row < y + height; row += rows)
+    {
+        // one window per group of rows sharing the same visible span
+        rows = gc9a01a_mask_rows(row, y + height - 1, x, x + width - 1, &cx0, &cx1);
+        if (cx0 > cx1)
+        { continue; }
+        gc9a01a_region_open(cx0, row, cx1, row + rows - 1);
+        gc9a01a_region_fill(color, (uint32_t)(cx1 - cx0 + 1) * rows);
+        gc9a01a_region_close();
+    }
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_draw_circle(int16_t x, int16_t y, int16_t radius, uint16_t color) {
+    GC9A01A_RECORD(GC9A01A_OP_DRAW_CIRCLE, color, NULL, x, y, radius);
     if (radius < 0)
         return;
+    gc9a01a_begin_transaction();
     int16_t xd = 0, yd = radius;
     int16_t d = 3 - 2 * radius;
 
@@ -622,51 +2074,54 @@ void gc9a01a_draw_circle(int16_t x, int16_t y, int16_t radius, uint16_t color) {
         xd++;
         if (d > 0)
         {
-            y--;
-            d = d + 4 * (x - y) + 10;
+            yd--;
+            d = d + 4 * (xd - yd) + 10;
         } else
-        { d = d + 4 * x + 6; }
+        { d = d + 4 * xd + 6; }
     }
 
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_fill_circle(int16_t x, int16_t y, int16_t radius, uint16_t color) {
+    GC9A01A_RECORD(GC9A01A_OP_FILL_CIRCLE, color, NULL, x, y, radius);
     if (radius < 0)
         return;
+    gc9a01a_begin_transaction();
     // we use midpoint circle algorthm to find the boundary, then draw horizental
     // spans between symmetric points
     int16_t xd = 0, yd = radius;
     int16_t d = 1 - radius;  // midpoint decision variable.
 
-    while (y >= x)
+    while (yd >= xd)
     {
-        // For each octant pair, draw the filled horizental spans:
-        gc9a01a_draw_line(x - xd, y + yd, x + xd, y + yd, color);
-        gc9a01a_draw_line(x - xd, y - yd, x + xd, y - yd, color);
-        gc9a01a_draw_line(x - yd, y + xd, x + yd, y + xd, color);
-        gc9a01a_draw_line(x - yd, y - xd, x + yd, y - xd, color);
+        // rows y +/- xd are reached once, rows y +/- yd are drawn at their
+        // widest, right before yd moves on
+        gc9a01a_draw_fast_horizental_line(x - yd, y + xd, 2 * yd + 1, color);
+        if (xd != 0)
+        { gc9a01a_draw_fast_horizental_line(x - yd, y - xd, 2 * yd + 1, color); }
 
-        ++xd;
         if (d < 0)
         {
-            d += (2 * x + 1);
+            d += (2 * xd + 3);
         } else
         {
-            --y;
-            d += (2 * (x - y) + 1);
+            if (yd != xd)
+            {
+                gc9a01a_draw_fast_horizental_line(x - xd, y + yd, 2 * xd + 1, color);
+                gc9a01a_draw_fast_horizental_line(x - xd, y - yd, 2 * xd + 1, color);
+            }
+            --yd;
+            d += (2 * (xd - yd) + 3);
         }
+        ++xd;
     }
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_draw_ellipse(int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color) {
+    GC9A01A_RECORD(GC9A01A_OP_DRAW_ELLIPSE, color, NULL, x, y, width, height);
+    gc9a01a_begin_transaction();
     int16_t xd = 0, yd = height;
     int32_t rw2 = width * width, rh2 = height * height;
     int32_t twoRw2 = 2 * rw2, twoRh2 = 2 * rh2;
@@ -674,26 +2129,26 @@ void gc9a01a_draw_ellipse(int16_t x, int16_t y, int16_t width, int16_t height, u
     int32_t decision = rh2 - (rw2 * height) + (rw2 / 4);
 
     // region 1
-    while ((twoRh2 * xd) < (twoRw2 * y))
+    while ((twoRh2 * xd) < (twoRw2 * yd))
     {
         gc9a01a_write_pixel(x + xd, y + yd, color);
         gc9a01a_write_pixel(x - xd, y + yd, color);
         gc9a01a_write_pixel(x + xd, y - yd, color);
         gc9a01a_write_pixel(x - xd, y - yd, color);
-        x++;
+        xd++;
         if (decision < 0)
         {
             decision += rh2 + (twoRh2 * xd);
         } else
         {
-            decision += rh2 + (twoRh2 * xd) - (twoRw2 * y);
-            y--;
+            yd--;
+            decision += rh2 + (twoRh2 * xd) - (twoRw2 * yd);
         }
     }
 
     // region 2
     decision =
-        ((rh2 * (2 * xd + 1) * (2 * x + 1)) >> 2) + (rw2 * (yd - 1) * (yd - 1)) - (rw2 * rh2);
+        ((rh2 * (2 * xd + 1) * (2 * xd + 1)) >> 2) + (rw2 * (yd - 1) * (yd - 1)) - (rw2 * rh2);
     while (yd >= 0)
     {
         gc9a01a_write_pixel(x + xd, y + yd, color);
@@ -706,17 +2161,16 @@ void gc9a01a_draw_ellipse(int16_t x, int16_t y, int16_t width, int16_t height, u
             decision += rw2 - (twoRw2 * yd);
         } else
         {
-            decision += rw2 + (twoRh2 * xd) - (twoRw2 * yd);
             xd++;
+            decision += rw2 + (twoRh2 * xd) - (twoRw2 * yd);
         }
     }
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_fill_ellipse(int16_t x0, int16_t y0, int16_t width, int16_t height, uint16_t color) {
+    GC9A01A_RECORD(GC9A01A_OP_FILL_ELLIPSE, color, NULL, x0, y0, width, height);
+    gc9a01a_begin_transaction();
     // Bresenham's ellipse algorithm
     int16_t x = 0, y = height;
     int32_t rw2 = width * width, rh2 = height * height;
@@ -757,25 +2211,82 @@ void gc9a01a_fill_ellipse(int16_t x0, int16_t y0, int16_t width, int16_t height,
             x++;
         }
     }
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_draw_triangle(int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_1, int16_t x_2,
                            int16_t y_2, uint16_t color) {
+    GC9A01A_RECORD(GC9A01A_OP_DRAW_TRIANGLE, color, NULL, x_0, y_0, x_1, y_1, x_2, y_2);
+    gc9a01a_begin_transaction();
     gc9a01a_draw_line(x_0, y_0, x_1, y_1, color);
     gc9a01a_draw_line(x_1, y_1, x_2, y_2, color);
     gc9a01a_draw_line(x_0, y_0, x_2, y_2, color);
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    gc9a01a_end_transaction();
+}
+
+void gc9a01a_edge_init(gc9a01a_edge_t *e, int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_1,
+                       int16_t y) {
+    int32_t dx = x_1 - x_0;
+    int64_t num = (int64_t)dx * (y - y_0);
+    int32_t q, r;
+
+    e->dy = y_1 - y_0;
+    e->step = dx / e->dy;
+    e->frac = dx % e->dy;
+    if (e->frac < 0)
+    {
+        e->step--;
+        e->frac += e->dy;
+    }
+    // round the crossing of row y up to the next column
+    q = num / e->dy;
+    r = num - (int64_t)q * e->dy;
+    if (r > 0)
+    {
+        q++;
+        r -= e->dy;
+    }
+    e->x = x_0 + q;
+    e->rem = -r;
+}
+
+/**
+ * Fill rows [y, y_end) from the left edge up to, not including, the right
+ * edge. Consecutive rows with the same span share one rectangle.
+ */
+static void gc9a01a_fill_edges(gc9a01a_edge_t *left, gc9a01a_edge_t *right, int16_t y,
+                               int16_t y_end, uint16_t color) {
+    int32_t x0, x1, run_x0 = 0, run_x1 = 0;
+    int16_t run_y = y;
+
+    for (; y < y_end; y++)
+    {
+        x0 = (left->x < clip.x0) ? clip.x0 : left->x;
+        x1 = (right->x > clip.x1 + 1) ? clip.x1 + 1 : right->x;
+        if (x1 < x0)
+        { x1 = x0; }
+        if ((x0 != run_x0) || (x1 != run_x1))
+        {
+            if (run_x1 > run_x0)
+            { gc9a01a_fill_rectangle(run_x0, run_y, run_x1 - run_x0, y - run_y, color); }
+            run_x0 = x0;
+            run_x1 = x1;
+            run_y = y;
+        }
+        gc9a01a_edge_step(left);
+        gc9a01a_edge_step(right);
+    }
+    if (run_x1 > run_x0)
+    { gc9a01a_fill_rectangle(run_x0, run_y, run_x1 - run_x0, y - run_y, color); }
 }
 
 void gc9a01a_fill_triangle(int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_1, int16_t x_2,
-                           int16_t y_2, int16_t color) {
+                           int16_t y_2, uint16_t color) {
+    GC9A01A_RECORD(GC9A01A_OP_FILL_TRIANGLE, color, NULL, x_0, y_0, x_1, y_1, x_2, y_2);
+    gc9a01a_edge_t long_edge, short_edge;
+    int64_t cross;
+    int16_t y, y_mid, y_end;
+
     // sort by Y
     if (y_0 > y_1)
     {
@@ -793,38 +2304,50 @@ void gc9a01a_fill_triangle(int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_1, i
         swap_int16_t(&x_0, &x_1);
     }
 
-    // Compute slopes
-    float dx02 = (x_2 - x_0) / (float)(y_2 - y_0 + 1);
-    float dx01 = (x_1 - x_0) / (float)(y_1 - y_0 + 1);
-    float dx12 = (x_2 - x_1) / (float)(y_2 - y_1 + 1);
-
-    float sx_0 = x_0;
-    float sx_1 = x_0;
+    // negative when the edge from the top to the bottom vertex is on the
+    // left of the middle vertex, zero for a degenerate triangle
+    cross = (int64_t)(x_2 - x_0) * (y_1 - y_0) - (int64_t)(x_1 - x_0) * (y_2 - y_0);
+    y = (y_0 < clip.y0) ? clip.y0 : y_0;
+    y_end = (y_2 > clip.y1 + 1) ? clip.y1 + 1 : y_2;
+    if ((cross == 0) || (y >= y_end))
+    { return; }
 
-    // --- fill top half ---
-    for (int16_t y = y_0; y <= y_1; ++y)
+    // top-left rule: pixel centers on a left or top edge are filled, on a
+    // right or bottom edge they are not, so triangles sharing an edge
+    // neither overlap nor leave a gap
+    gc9a01a_begin_transaction();
+    gc9a01a_edge_init(&long_edge, x_0, y_0, x_2, y_2, y);
+    y_mid = (y_1 < y_end) ? y_1 : y_end;
+    if (y < y_mid)
     {
-        gc9a01a_draw_fast_horizental_line((int)sx_0, y, (int16_t)(sx_1 - sx_0), color);
-        sx_0 += dx02;
-        sx_1 += dx01;
+        gc9a01a_edge_init(&short_edge, x_0, y_0, x_1, y_1, y);
+        if (cross < 0)
+        {
+            gc9a01a_fill_edges(&long_edge, &short_edge, y, y_mid, color);
+        } else
+        {
+            gc9a01a_fill_edges(&short_edge, &long_edge, y, y_mid, color);
+        }
+        y = y_mid;
     }
-
-    // --- fill bottom half ---
-    sx_1 += x_1;
-    for (int16_t y = y_0; y <= y_1; ++y)
+    if (y < y_end)
     {
-        gc9a01a_draw_fast_horizental_line((int)sx_0, (int)sx_1, y, color);
-        sx_0 += dx02;
-        sx_1 += dx12;
+        gc9a01a_edge_init(&short_edge, x_1, y_1, x_2, y_2, y);
+        if (cross < 0)
+        {
+            gc9a01a_fill_edges(&long_edge, &short_edge, y, y_end, color);
+        } else
+        {
+            gc9a01a_fill_edges(&short_edge, &long_edge, y, y_end, color);
+        }
     }
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_draw_round_rectangle(int16_t x, int16_t y, int16_t width, int16_t height,
                                   int16_t radius, uint16_t color) {
+    GC9A01A_RECORD(GC9A01A_OP_DRAW_ROUND_RECTANGLE, color, NULL, x, y, width, height, radius);
+    gc9a01a_begin_transaction();
     int16_t max_radius = ((width < height) ? width : height) / 2;
     if (radius > max_radius)
         radius = max_radius;
@@ -839,14 +2362,13 @@ void gc9a01a_draw_round_rectangle(int16_t x, int16_t y, int16_t width, int16_t h
     gc9a01a_draw_round_corner(x + width - radius - 1, y + radius, radius, 2, color);
     gc9a01a_draw_round_corner(x + width - radius - 1, y + height - radius - 1, radius, 4, color);
     gc9a01a_draw_round_corner(x + radius, y + height - radius - 1, radius, 8, color);
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_draw_round_corner(int16_t x, int16_t y, int16_t r, uint8_t cornername,
                                uint16_t color) {
+    GC9A01A_RECORD(GC9A01A_OP_DRAW_ROUND_CORNER, color, NULL, x, y, r, cornername);
+    gc9a01a_begin_transaction();
     int16_t f = 1 - r;
     int16_t ddF_x = 1;
     int16_t ddF_y = -2 * r;
@@ -885,14 +2407,13 @@ void gc9a01a_draw_round_corner(int16_t x, int16_t y, int16_t r, uint8_t cornerna
             gc9a01a_write_pixel(x - xc, y - yc, color);
         }
     }
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_fill_round_rectangle(int16_t x, int16_t y, int16_t width, int16_t height,
                                   int16_t radius, uint16_t color) {
+    GC9A01A_RECORD(GC9A01A_OP_FILL_ROUND_RECTANGLE, color, NULL, x, y, width, height, radius);
+    gc9a01a_begin_transaction();
     int16_t max_radius = ((width < height) ? width : height) / 2;  // 1/2 minor axis
     if (radius > max_radius)
         radius = max_radius;
@@ -902,14 +2423,13 @@ void gc9a01a_fill_round_rectangle(int16_t x, int16_t y, int16_t width, int16_t h
     gc9a01a_fill_round_corner(x + width - radius - 1, y + radius, radius, 1,
                               height - 2 * radius - 1, color);
     gc9a01a_fill_round_corner(x + radius, y + radius, radius, 2, height - 2 * radius - 1, color);
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_fill_round_corner(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta,
                                uint16_t color) {
+    GC9A01A_RECORD(GC9A01A_OP_FILL_ROUND_CORNER, color, NULL, x0, y0, r, corners, delta);
+    gc9a01a_begin_transaction();
     int16_t f = 1 - r;
     int16_t ddF_x = 1;
     int16_t ddF_y = -2 * r;
@@ -950,17 +2470,29 @@ void gc9a01a_fill_round_corner(int16_t x0, int16_t y0, int16_t r, uint8_t corner
         }
         px = x;
     }
-#if USE_DMA
-    while (tx_busy)
-        ;
-#endif
+    gc9a01a_end_transaction();
 }
 
 void gc9a01a_fill_screen(uint16_t color) {
-    gc9a01a_fill_rectangle(0, GC9A01A_TFTWIDTH, 0, GC9A01A_TFTHEIGHT, color);
-#if USE_DMA
-    while (tx_busy)
-        ;
+    GC9A01A_RECORD(GC9A01A_OP_FILL_SCREEN, color, NULL, 0);
+    gc9a01a_fill_rectangle(0, 0, GC9A01A_TFTWIDTH, GC9A01A_TFTHEIGHT, color);
+}
+
+void gc9a01a_get_stats(gc9a01a_stats_t *out) {
+#if GC9A01A_ENABLE_STATS
+    *out = stats;
+#else
+    out->transactions = 0;
+    out->commands = 0;
+    out->data_bytes = 0;
+#endif
+}
+
+void gc9a01a_reset_stats(void) {
+#if GC9A01A_ENABLE_STATS
+    stats.transactions = 0;
+    stats.commands = 0;
+    stats.data_bytes = 0;
 #endif
 }
 
@@ -972,6 +2504,8 @@ const gfx_display_driver_t gc9a01a_driver = {
     .draw_image = gc9a01a_draw_image,
     .fill_screen = gc9a01a_fill_screen,
     .write_pixel = gc9a01a_write_pixel,
+    .draw_fast_vertical_line = gc9a01a_draw_fast_vertical_line,
+    .draw_fast_horizental_line = gc9a01a_draw_fast_horizental_line,
     .orientation = gc9a01a_set_orientation,
     .fill_rectangle = gc9a01a_fill_rectangle,
 };
\ No newline at end of file
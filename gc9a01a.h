@@ -23,12 +23,15 @@
 #define GC9A01A_H
 
 /* Includes --------------------------------------------------------------- */
+#include "gc9a01a_transport.h"
 #include "gfx_display.h"
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 
-#include "main.h"
+#if !defined(GC9A01A_DEFAULT_TRANSPORT) && defined(USE_HAL_DRIVER)
+#define GC9A01A_DEFAULT_TRANSPORT gc9a01a_stm32_transport  ///< Bus used until set_transport
+#endif
 
 #define GC9A01A_TFTWIDTH 240   ///< Display width in pixels
 #define GC9A01A_TFTHEIGHT 240  ///< Display hight in pixels
@@ -124,22 +127,103 @@
 #define GC9A01A_GREENYELLOW 0xAFE5  ///< 173, 255,  41
 #define GC9A01A_PINK 0xFC18         ///< 255, 130, 198
 
-#define GC9A01A_SPI hspi2
-#define GC9A01A_SPI_TIMEOUT 100
+#ifndef USE_DMA
 #define USE_DMA 0
+#endif
 
-#define GC9A01A_CS_PORT GPIOB
-#define GC9A01A_CS_PIN LCD_CS_Pin
+/**
+ * Init sequences are byte tables of {command, length, parameters...}
+ * entries. When GC9A01A_INIT_DELAY is set in the length byte, one more byte
+ * follows the parameters with a delay in milliseconds. The table ends with
+ * GC9A01A_INIT_END.
+ */
+#define GC9A01A_INIT_DELAY 0x80
+#define GC9A01A_INIT_END 0x00, 0xFF
+
+#ifndef GC9A01A_TX_BUF_SIZE
+#define GC9A01A_TX_BUF_SIZE 960  ///< Pixel transmit buffer in bytes (two 240 pixel lines)
+#endif
+
+#ifndef GC9A01A_TX_BUF_COUNT
+#define GC9A01A_TX_BUF_COUNT 2  ///< Transmit buffers rotated through the DMA when USE_DMA is set
+#endif
+
+#ifndef GC9A01A_FRAMEBUFFER
+#define GC9A01A_FRAMEBUFFER 0  ///< Render into a 115,200 byte frame, sent by gc9a01a_flush()
+#endif
+
+#ifndef GC9A01A_BAND_LINES
+#define GC9A01A_BAND_LINES 0  ///< Rows of the strip buffer of the banded renderer, 0 disables it
+#endif
+
+#ifndef GC9A01A_BAND_RECORDS
+#define GC9A01A_BAND_RECORDS 64  ///< Draw calls recorded between two banded flushes
+#endif
+
+#ifndef GC9A01A_BAND_TEXT_SIZE
+#define GC9A01A_BAND_TEXT_SIZE 512  ///< Bytes kept for the strings of recorded write_string calls
+#endif
+
+#ifndef GC9A01A_DIRTY_RECTS
+#define GC9A01A_DIRTY_RECTS 8  ///< Dirty rectangles tracked between two framebuffer flushes
+#endif
+
+#ifndef GC9A01A_ROUND_MASK
+#define GC9A01A_ROUND_MASK 0  ///< Skip the pixels outside the round glass in fills, images and flushes
+#endif
 
-#define GC9A01A_DC_PORT GPIOB
-#define GC9A01A_DC_PIN LCD_DC_Pin
+#ifndef GC9A01A_ROUND_MASK_MIN
+#define GC9A01A_ROUND_MASK_MIN 3  ///< Pixels a row side must lose before it gets its own window
+#endif
 
-#define GC9A01A_RST_PORT GPIOB
-#define GC9A01A_RST_PIN LCD_RST_Pin
+#ifndef GC9A01A_FRAME_DIFF
+#define GC9A01A_FRAME_DIFF 0  ///< Flush only what changed: 1 with row segment hashes, 2 with a copy of the sent frame
+#endif
+
+#ifndef GC9A01A_DIFF_SEGMENT
+#define GC9A01A_DIFF_SEGMENT 24  ///< Width in pixels of the row segments compared by GC9A01A_FRAME_DIFF
+#endif
+
+#ifndef GC9A01A_ENABLE_STATS
+#define GC9A01A_ENABLE_STATS 0  ///< Count bus traffic, read back with gc9a01a_get_stats()
+#endif
+
+/**
+ * @brief Bus traffic counters, only updated when GC9A01A_ENABLE_STATS is set.
+ * @param transactions number of CS-low periods.
+ * @param commands number of command bytes sent.
+ * @param data_bytes number of data bytes sent.
+ */
+typedef struct
+{
+    uint32_t transactions;
+    uint32_t commands;
+    uint32_t data_bytes;
+} gc9a01a_stats_t;
+
+/**
+ * @brief Pixel bytes of the last flush when GC9A01A_FRAME_DIFF is set.
+ * @param bytes_total pixel bytes the flush covered.
+ * @param bytes_sent pixel bytes that differed from the panel and were sent.
+ * @param bytes_saved bytes_total - bytes_sent.
+ */
+typedef struct
+{
+    uint32_t bytes_total;
+    uint32_t bytes_sent;
+    uint32_t bytes_saved;
+} gc9a01a_diff_stats_t;
+
+extern const uint8_t gc9a01a_init_sequence_default[];
 
 void gc9a01a_hw_reset(void);
+void gc9a01a_set_init_sequence(const uint8_t *sequence);
 void gc9a01a_configure(void);
 void gc9a01a_init(void);
+void gc9a01a_begin_transaction(void);
+void gc9a01a_end_transaction(void);
+void gc9a01a_wait_idle(void);
+void gc9a01a_flush_ready(void);
 void gc9a01a_write_cmd(uint8_t cmd);
 void gc9a01a_write_data(uint8_t data);
 void gc9a01a_write_data_buf(uint8_t *data, uint32_t size);
@@ -163,7 +247,7 @@ void gc9a01a_fill_ellipse(int16_t x, int16_t y, int16_t width, int16_t height, u
 void gc9a01a_draw_triangle(int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_1, int16_t x_2,
                            int16_t y_2, uint16_t color);
 void gc9a01a_fill_triangle(int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_1, int16_t x_2,
-                           int16_t y_2, int16_t color);
+                           int16_t y_2, uint16_t color);
 void gc9a01a_draw_round_corner(int16_t x, int16_t y, int16_t r, uint8_t cornername, uint16_t color);
 void gc9a01a_fill_round_corner(int16_t x0, int16_t y0, int16_t r, uint8_t corners, int16_t delta,
                                uint16_t color);
@@ -172,5 +256,14 @@ void gc9a01a_draw_round_rectangle(int16_t x_0, int16_t y_0, int16_t width, int16
 void gc9a01a_fill_round_rectangle(int16_t x_0, int16_t y_0, int16_t width, int16_t height,
                                   int16_t radius, uint16_t color);
 void gc9a01a_fill_screen(uint16_t color);
+/* Framebuffer and banded modes, gc9a01a_flush() sends what was drawn to the panel */
+void gc9a01a_flush(void);
+void gc9a01a_set_background(uint16_t color);
+void gc9a01a_invalidate(void);
+void gc9a01a_get_diff_stats(gc9a01a_diff_stats_t *stats);
+uint16_t *gc9a01a_get_framebuffer(void);
+void gc9a01a_mark_dirty(int16_t x, int16_t y, int16_t width, int16_t height);
+void gc9a01a_get_stats(gc9a01a_stats_t *stats);
+void gc9a01a_reset_stats(void);
 
 #endif /* GC9A01A_H */
\ No newline at end of file
@@ -0,0 +1,605 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_arc.c
+ * @author  Nabli Hatem
+ * @brief   This module contains the arc, ring segment and gauge primitives.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#include "gc9a01a_arc.h"
+#include "gc9a01a_blend.h"
+#include "gc9a01a_internal.h"
+
+#define GC9A01A_ARC_ONE 16384        ///< Length of the edge directions, one pixel of distance
+#define GC9A01A_ARC_HALF 8192        ///< Half a pixel of distance to an edge
+#define GC9A01A_ARC_FAR (1L << 24)   ///< Column bound of a row side without limit
+
+#define GC9A01A_ARC_SOLID 0  ///< Whole pixels in the color
+#define GC9A01A_ARC_BLEND 1  ///< Edges blended into what was drawn
+#define GC9A01A_ARC_OVER 2   ///< Round edges blended into bgcolor, straight edges solid
+
+/**
+ * Sine of 0 to 90 degrees, GC9A01A_ARC_ONE is 1.
+ */
+static const uint16_t arc_sine[91] = {
+    0,     286,   572,   857,   1143,  1428,  1713,  1997,  2280,  2563,  2845,  3126,  3406,
+    3686,  3964,  4240,  4516,  4790,  5063,  5334,  5604,  5872,  6138,  6402,  6664,  6924,
+    7182,  7438,  7692,  7943,  8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860,  10087,
+    10311, 10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365, 12551, 12733,
+    12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044, 14189, 14330, 14466, 14598, 14726,
+    14849, 14968, 15082, 15191, 15296, 15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964,
+    16026, 16083, 16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382, 16384,
+};
+
+/**
+ * Arc prepared for drawing. A pixel dx, dy from the center is on the inner
+ * side of edge k when ux[k] * dy - uy[k] * dx, its distance to the edge
+ * line in 1 / GC9A01A_ARC_ONE pixels, is positive.
+ */
+typedef struct
+{
+    int16_t x;
+    int16_t y;
+    int32_t inner;
+    int32_t outer;
+    int32_t solid_in2;   ///< Squared distances of the pixels the inner edge does not cross
+    int32_t solid_out2;  ///< Squared distances of the pixels the outer edge does not cross
+    int32_t ux[2];
+    int32_t uy[2];
+    uint8_t sides;   ///< 0 for the whole ring, 1 for half of it, 2 for a wedge
+    uint8_t invert;  ///< 1 when the arc is the ring without the wedge
+    uint8_t mode;
+    uint16_t color;
+    uint16_t bgcolor;
+} gc9a01a_arc_t;
+
+/**
+ * Direction of an angle, clockwise from 12 o'clock on the screen.
+ */
+static void gc9a01a_arc_direction(int32_t angle, int32_t *ux, int32_t *uy) {
+    int32_t a = angle % 360, r, s, c;
+
+    if (a < 0)
+    { a += 360; }
+    r = a % 90;
+    switch (a / 90)
+    {
+        case 0:
+            s = arc_sine[r];
+            c = arc_sine[90 - r];
+            break;
+        case 1:
+            s = arc_sine[90 - r];
+            c = -arc_sine[r];
+            break;
+        case 2:
+            s = -arc_sine[r];
+            c = -arc_sine[90 - r];
+            break;
+        default:
+            s = -arc_sine[90 - r];
+            c = arc_sine[r];
+            break;
+    }
+    *ux = s;
+    *uy = -c;
+}
+
+static uint8_t gc9a01a_arc_setup(gc9a01a_arc_t *arc, int16_t x, int16_t y, int16_t inner,
+                                 int16_t outer, int16_t start, int16_t end) {
+    int32_t sweep = (int32_t)end - start;
+
+    if ((outer < 0) || (outer > GC9A01A_ARC_MAX_RADIUS) || (inner > outer))
+        return 0;
+    arc->x = x;
+    arc->y = y;
+    arc->inner = (inner < 0) ? 0 : inner;
+    arc->outer = outer;
+    arc->solid_in2 = (arc->inner > 0) ? arc->inner * arc->inner + arc->inner + 1 : 0;
+    arc->solid_out2 = (outer > 0) ? arc->outer * arc->outer - arc->outer : -1;
+    arc->sides = 2;
+    arc->invert = 0;
+    if (sweep >= 360)
+    {
+        arc->sides = 0;
+        return 1;
+    }
+    sweep %= 360;
+    if (sweep < 0)
+    { sweep += 360; }
+    if (sweep == 0)
+        return 0;
+
+    if (sweep == 180)
+    {
+        arc->sides = 1;
+        gc9a01a_arc_direction(start, &arc->ux[0], &arc->uy[0]);
+    } else if (sweep < 180)
+    {
+        // at or after start, and before end
+        gc9a01a_arc_direction(start, &arc->ux[0], &arc->uy[0]);
+        gc9a01a_arc_direction(end, &arc->ux[1], &arc->uy[1]);
+    } else
+    {
+        // the ring without the wedge from end to start
+        arc->invert = 1;
+        gc9a01a_arc_direction(end, &arc->ux[0], &arc->uy[0]);
+        gc9a01a_arc_direction(start, &arc->ux[1], &arc->uy[1]);
+    }
+    if (arc->sides == 2)
+    {
+        arc->ux[1] = -arc->ux[1];
+        arc->uy[1] = -arc->uy[1];
+    }
+    return 1;
+}
+
+static inline int32_t gc9a01a_floor_div(int32_t n, int32_t d) {
+    int32_t q = n / d;
+
+    if (((n % d) != 0) && ((n < 0) != (d < 0)))
+    { q--; }
+    return q;
+}
+
+/**
+ * Columns dx of row dy where ux * dy - uy * dx + bias > 0, empty when lo > hi.
+ */
+static void gc9a01a_arc_side(int32_t ux, int32_t uy, int32_t dy, int32_t bias, int32_t *lo,
+                             int32_t *hi) {
+    int32_t n = ux * dy + bias;
+
+    *lo = -GC9A01A_ARC_FAR;
+    *hi = GC9A01A_ARC_FAR;
+    if (uy > 0)
+    {
+        *hi = -gc9a01a_floor_div(-n, uy) - 1;
+    } else if (uy < 0)
+    {
+        *lo = gc9a01a_floor_div(n, uy) + 1;
+    } else if (n <= 0)
+    {
+        *lo = GC9A01A_ARC_FAR;
+        *hi = -GC9A01A_ARC_FAR;
+    }
+}
+
+/**
+ * Add the pixel of the start ray to the columns of row dy past the line of
+ * a half ring, the other pixels of the line belong to the other half.
+ */
+static void gc9a01a_arc_start_ray(const gc9a01a_arc_t *arc, int32_t dy, int32_t *spans) {
+    int32_t ux = arc->ux[0], uy = arc->uy[0], n = ux * dy;
+
+    if (uy == 0)
+    {
+        if (dy == 0)
+        {
+            spans[0] = (ux > 0) ? 1 : -GC9A01A_ARC_FAR;
+            spans[1] = (ux > 0) ? GC9A01A_ARC_FAR : -1;
+        }
+        return;
+    }
+    if ((n % uy == 0) && (ux * (n / uy) + uy * dy > 0))
+    {
+        if (uy > 0)
+        {
+            spans[1] = n / uy;
+        } else
+        {
+            spans[0] = n / uy;
+        }
+    }
+}
+
+/**
+ * Columns of row dy between the angles of the arc, in up to two spans. With
+ * aa, the columns the straight edges partly cover are included.
+ */
+static uint8_t gc9a01a_arc_sector(const gc9a01a_arc_t *arc, int32_t dy, uint8_t aa,
+                                  int32_t *spans) {
+    int32_t lo, hi, bias = aa ? GC9A01A_ARC_HALF : 1;
+
+    if (arc->sides == 0)
+    {
+        spans[0] = -GC9A01A_ARC_FAR;
+        spans[1] = GC9A01A_ARC_FAR;
+        return 1;
+    }
+    if (arc->sides == 1)
+    {
+        gc9a01a_arc_side(arc->ux[0], arc->uy[0], dy, aa ? bias : 0, &spans[0], &spans[1]);
+        if (!aa)
+        { gc9a01a_arc_start_ray(arc, dy, spans); }
+        return (spans[0] <= spans[1]);
+    }
+
+    // the wedge: at or after its first edge, before its second
+    if (aa && arc->invert)
+    { bias = 1 - GC9A01A_ARC_HALF; }
+    gc9a01a_arc_side(arc->ux[0], arc->uy[0], dy, bias, &spans[0], &spans[1]);
+    gc9a01a_arc_side(arc->ux[1], arc->uy[1], dy, aa ? bias : 0, &lo, &hi);
+    if (lo > spans[0])
+    { spans[0] = lo; }
+    if (hi < spans[1])
+    { spans[1] = hi; }
+    if (!arc->invert)
+        return (spans[0] <= spans[1]);
+    if (spans[0] > spans[1])
+    {
+        spans[0] = -GC9A01A_ARC_FAR;
+        spans[1] = GC9A01A_ARC_FAR;
+        return 1;
+    }
+    spans[3] = GC9A01A_ARC_FAR;
+    spans[2] = spans[1] + 1;
+    spans[1] = spans[0] - 1;
+    spans[0] = -GC9A01A_ARC_FAR;
+    return 2;
+}
+
+/**
+ * Columns of row dy whose distance to the center is between inner and
+ * outer, in up to two spans.
+ */
+static uint8_t gc9a01a_ring_spans(int32_t inner, int32_t outer, int32_t dy, int32_t *spans) {
+    uint32_t dy2 = dy * dy, half, hole;
+
+    if ((outer < 0) || (dy2 > (uint32_t)(outer * outer)))
+        return 0;
+    half = gc9a01a_isqrt(outer * outer - dy2);
+    if ((inner <= 0) || (dy2 >= (uint32_t)(inner * inner)))
+    {
+        spans[0] = -(int32_t)half;
+        spans[1] = half;
+        return 1;
+    }
+    hole = gc9a01a_isqrt(inner * inner - dy2 - 1);
+    if (hole >= half)
+        return 0;
+    spans[0] = -(int32_t)half;
+    spans[1] = -(int32_t)hole - 1;
+    spans[2] = hole + 1;
+    spans[3] = half;
+    return 2;
+}
+
+/**
+ * Part of a pixel on the inner side of an edge, 256 for all of it.
+ */
+static inline int32_t gc9a01a_arc_cover(int32_t distance) {
+    if (distance <= -GC9A01A_ARC_HALF)
+        return 0;
+    if (distance >= GC9A01A_ARC_HALF)
+        return 256;
+    return (distance + GC9A01A_ARC_HALF) >> 6;
+}
+
+/**
+ * Part of a pixel at squared distance d2 between the inner and outer
+ * radius, 256 for all of it.
+ */
+static inline int32_t gc9a01a_arc_radial(const gc9a01a_arc_t *arc, int32_t d2) {
+    int32_t d, cover, inside;
+
+    if ((d2 <= arc->solid_out2) && (d2 >= arc->solid_in2))
+        return 256;
+    // distance in 1/16 pixel, only for the pixels an edge crosses
+    d = gc9a01a_isqrt((uint32_t)d2 << 8);
+    cover = (16 * arc->outer + 8 - d) * 16;
+    if (cover > 256)
+    { cover = 256; }
+    if (arc->inner > 0)
+    {
+        inside = (d - 16 * arc->inner + 8) * 16;
+        if (inside < 256)
+        { cover = (cover * inside) >> 8; }
+    }
+    return (cover < 0) ? 0 : cover;
+}
+
+static void gc9a01a_arc_blend(uint16_t *dst, const uint8_t *src, uint16_t count, uint16_t color) {
+    gc9a01a_blend_span(dst, NULL, color, src, count);
+}
+
+/**
+ * Draw the columns lo..hi of row dy with the coverage of each pixel.
+ */
+static void gc9a01a_arc_aa_span(const gc9a01a_arc_t *arc, int32_t dy, int32_t lo, int32_t hi) {
+    uint8_t alpha[GC9A01A_TFTWIDTH];
+    uint16_t line[GC9A01A_TFTWIDTH];
+    int32_t d2 = lo * lo + dy * dy, c_0 = 0, c_1 = 0, a, dx;
+    uint16_t i, j, k, m, n = hi - lo + 1;
+    uint8_t solid;
+
+    if (arc->mode == GC9A01A_ARC_BLEND)
+    {
+        c_0 = arc->ux[0] * dy - arc->uy[0] * lo;
+        c_1 = arc->ux[1] * dy - arc->uy[1] * lo;
+    }
+    for (dx = lo, i = 0; i < n; dx++, i++)
+    {
+        a = 256;
+        if ((arc->mode == GC9A01A_ARC_BLEND) && (arc->sides != 0))
+        {
+            a = gc9a01a_arc_cover(c_0);
+            if (arc->sides == 2)
+            { a = (a * gc9a01a_arc_cover(c_1)) >> 8; }
+            if (arc->invert)
+            { a = 256 - a; }
+            c_0 -= arc->uy[0];
+            c_1 -= arc->uy[1];
+        }
+        a = (a * gc9a01a_arc_radial(arc, d2)) >> 8;
+        alpha[i] = (a > 255) ? 255 : a;
+        d2 += 2 * dx + 1;
+    }
+
+    // one window for each run of covered pixels
+    for (i = 0; i < n; i = k)
+    {
+        k = i;
+        while ((k < n) && (alpha[k] != 0))
+        { k++; }
+        if (k == i)
+        {
+            k++;
+            continue;
+        }
+        gc9a01a_region_begin(arc->x + lo + i, arc->y + dy, arc->x + lo + k - 1, arc->y + dy);
+        if (arc->mode == GC9A01A_ARC_OVER)
+        {
+            for (j = i; j < k; j++)
+            { line[j] = gc9a01a_to_bus(arc->bgcolor); }
+            gc9a01a_blend_span(line + i, NULL, arc->color, alpha + i, k - i);
+            gc9a01a_region_write_bus((const uint8_t *)(line + i), k - i);
+        } else
+        {
+            for (j = i; j < k; j = m)
+            {
+                solid = (alpha[j] == 255);
+                m = j;
+                while ((m < k) && ((alpha[m] == 255) == solid))
+                { m++; }
+                if (solid)
+                {
+                    gc9a01a_region_repeat(arc->color, m - j);
+                } else
+                {
+                    gc9a01a_region_blend(gc9a01a_arc_blend, alpha + j, 1, m - j, arc->color);
+                }
+            }
+        }
+        gc9a01a_region_end();
+    }
+}
+
+/**
+ * Draw the columns lo..hi of row dy clipped to the screen.
+ */
+static void gc9a01a_arc_span(const gc9a01a_arc_t *arc, int32_t dy, int32_t lo, int32_t hi) {
+    if (lo < -arc->x)
+    { lo = -arc->x; }
+    if (hi > GC9A01A_TFTWIDTH - 1 - arc->x)
+    { hi = GC9A01A_TFTWIDTH - 1 - arc->x; }
+    if (lo > hi)
+        return;
+    if (arc->mode == GC9A01A_ARC_SOLID)
+    {
+        gc9a01a_fill_rectangle(arc->x + lo, arc->y + dy, hi - lo + 1, 1, arc->color);
+    } else
+    {
+        gc9a01a_arc_aa_span(arc, dy, lo, hi);
+    }
+}
+
+/**
+ * Narrow the rows dy..dy_end to those a wedge reaches: the rows of its
+ * corners, and the top or the bottom of the ring when it holds 12 or 6
+ * o'clock.
+ */
+static void gc9a01a_arc_rows(const gc9a01a_arc_t *arc, int32_t *dy, int32_t *dy_end) {
+    int32_t ys[4], top, bottom;
+    uint8_t i;
+
+    if ((arc->sides != 2) || arc->invert)
+        return;
+    ys[0] = arc->uy[0] * arc->outer;
+    ys[1] = -arc->uy[1] * arc->outer;
+    ys[2] = arc->uy[0] * arc->inner;
+    ys[3] = -arc->uy[1] * arc->inner;
+    top = bottom = ys[0];
+    for (i = 1; i < 4; i++)
+    {
+        if (ys[i] < top)
+        { top = ys[i]; }
+        if (ys[i] > bottom)
+        { bottom = ys[i]; }
+    }
+    top = gc9a01a_floor_div(top, GC9A01A_ARC_ONE) - 2;
+    bottom = gc9a01a_floor_div(bottom, GC9A01A_ARC_ONE) + 2;
+    if ((top > *dy) && ((arc->ux[0] > 0) || (arc->ux[1] > 0)))
+    { *dy = top; }
+    if ((bottom < *dy_end) && ((arc->ux[0] < 0) || (arc->ux[1] < 0)))
+    { *dy_end = bottom; }
+}
+
+static void gc9a01a_arc_draw(const gc9a01a_arc_t *arc) {
+    int32_t ring[4], sector[4], dy, dy_end, lo, hi;
+    int32_t grow = (arc->mode == GC9A01A_ARC_SOLID) ? 0 : 1;
+    uint8_t rings, sectors, i, k, center = 0;
+
+    // every edge line goes through the center, so the center pixel of a
+    // pie goes to the arc holding the pixel above it, like a partition
+    if ((arc->inner == 0) && (arc->mode != GC9A01A_ARC_BLEND))
+    {
+        sectors = gc9a01a_arc_sector(arc, -1, 0, sector);
+        for (k = 0; k < sectors; k++)
+        { center |= (sector[2 * k] <= 0) && (sector[2 * k + 1] >= 0); }
+    }
+    dy = -arc->outer - grow;
+    dy_end = arc->outer + grow;
+    gc9a01a_arc_rows(arc, &dy, &dy_end);
+    if (arc->y + dy < 0)
+    { dy = -arc->y; }
+    if (arc->y + dy_end > GC9A01A_TFTHEIGHT - 1)
+    { dy_end = GC9A01A_TFTHEIGHT - 1 - arc->y; }
+
+    gc9a01a_begin_transaction();
+    for (; dy <= dy_end; dy++)
+    {
+        // anti-aliased rows also take the pixels the round edges cross
+        rings = gc9a01a_ring_spans(arc->inner - grow, arc->outer + grow, dy, ring);
+        if (rings == 0)
+        { continue; }
+        if ((dy == 0) && (arc->inner == 0) && (arc->mode != GC9A01A_ARC_BLEND))
+        {
+            ring[3] = ring[1];
+            ring[2] = 1;
+            ring[1] = -1;
+            rings = 2;
+            if (center)
+            { gc9a01a_arc_span(arc, 0, 0, 0); }
+        }
+        sectors = gc9a01a_arc_sector(arc, dy, arc->mode == GC9A01A_ARC_BLEND, sector);
+        for (i = 0; i < rings; i++)
+        {
+            for (k = 0; k < sectors; k++)
+            {
+                lo = (ring[2 * i] > sector[2 * k]) ? ring[2 * i] : sector[2 * k];
+                hi = (ring[2 * i + 1] < sector[2 * k + 1]) ? ring[2 * i + 1] : sector[2 * k + 1];
+                gc9a01a_arc_span(arc, dy, lo, hi);
+            }
+        }
+    }
+    gc9a01a_end_transaction();
+}
+
+static void gc9a01a_arc_replay(const int16_t *args, uint16_t color, const void *data) {
+    (void)data;
+    gc9a01a_fill_arc(args[0], args[1], args[2], args[3], args[4], args[5], color);
+}
+
+void gc9a01a_fill_arc(int16_t x, int16_t y, int16_t inner, int16_t outer, int16_t start,
+                      int16_t end, uint16_t color) {
+    const int16_t args[] = {x, y, inner, outer, start, end};
+    gc9a01a_arc_t arc;
+
+    if (gc9a01a_record_call(gc9a01a_arc_replay, args, 6, color, NULL))
+        return;
+    if (!gc9a01a_arc_setup(&arc, x, y, inner, outer, start, end))
+        return;
+    arc.mode = GC9A01A_ARC_SOLID;
+    arc.color = color;
+    gc9a01a_arc_draw(&arc);
+}
+
+static void gc9a01a_arc_aa_replay(const int16_t *args, uint16_t color, const void *data) {
+    (void)data;
+    gc9a01a_fill_arc_aa(args[0], args[1], args[2], args[3], args[4], args[5], color);
+}
+
+void gc9a01a_fill_arc_aa(int16_t x, int16_t y, int16_t inner, int16_t outer, int16_t start,
+                         int16_t end, uint16_t color) {
+    const int16_t args[] = {x, y, inner, outer, start, end};
+    gc9a01a_arc_t arc;
+
+    if (gc9a01a_record_call(gc9a01a_arc_aa_replay, args, 6, color, NULL))
+        return;
+    if (!gc9a01a_arc_setup(&arc, x, y, inner, outer, start, end))
+        return;
+    arc.mode = GC9A01A_ARC_BLEND;
+    arc.color = color;
+    gc9a01a_arc_draw(&arc);
+}
+
+static void gc9a01a_gauge_sector(const gc9a01a_gauge_t *gauge, int16_t start, int16_t end,
+                                 uint16_t color);
+
+static void gc9a01a_gauge_replay(const int16_t *args, uint16_t color, const void *data) {
+    gc9a01a_gauge_sector(data, args[0], args[1], color);
+}
+
+/**
+ * Draw the scale between two angles in one color. The sectors of a gauge
+ * share straight edges, so those stay solid and only the round edges are
+ * blended, into bgcolor so that redrawing a sector gives the same pixels.
+ */
+static void gc9a01a_gauge_sector(const gc9a01a_gauge_t *gauge, int16_t start, int16_t end,
+                                 uint16_t color) {
+    const int16_t args[] = {start, end};
+    gc9a01a_arc_t arc;
+
+    if (start >= end)
+        return;
+    if (gc9a01a_record_call(gc9a01a_gauge_replay, args, 2, color, gauge))
+        return;
+    if (!gc9a01a_arc_setup(&arc, gauge->x, gauge->y, gauge->inner, gauge->outer, start, end))
+        return;
+    arc.mode = gauge->aa ? GC9A01A_ARC_OVER : GC9A01A_ARC_SOLID;
+    arc.color = color;
+    arc.bgcolor = gauge->bgcolor;
+    gc9a01a_arc_draw(&arc);
+}
+
+/**
+ * Draw the scale from angle start to angle end as it looks for the value.
+ */
+static void gc9a01a_gauge_paint(const gc9a01a_gauge_t *gauge, int16_t start, int16_t end) {
+    int16_t needle_0 = gauge->angle - gauge->needle / 2;
+    int16_t needle_1 = needle_0 + gauge->needle;
+
+    if (start < gauge->start)
+    { start = gauge->start; }
+    if (end > gauge->end)
+    { end = gauge->end; }
+    gc9a01a_gauge_sector(gauge, start, (end < needle_0) ? end : needle_0, gauge->color);
+    gc9a01a_gauge_sector(gauge, (start > needle_0) ? start : needle_0,
+                         (end < needle_1) ? end : needle_1, gauge->needle_color);
+    gc9a01a_gauge_sector(gauge, (start > needle_1) ? start : needle_1, end, gauge->track);
+}
+
+static int16_t gc9a01a_gauge_clamp(const gc9a01a_gauge_t *gauge, int16_t angle) {
+    if (angle < gauge->start)
+        return gauge->start;
+    if (angle > gauge->end)
+        return gauge->end;
+    return angle;
+}
+
+void gc9a01a_draw_gauge(gc9a01a_gauge_t *gauge, int16_t angle) {
+    gauge->angle = gc9a01a_gauge_clamp(gauge, angle);
+    gc9a01a_gauge_paint(gauge, gauge->start, gauge->end);
+}
+
+void gc9a01a_update_gauge(gc9a01a_gauge_t *gauge, int16_t angle) {
+    int16_t from = gauge->angle, half = gauge->needle / 2;
+
+    angle = gc9a01a_gauge_clamp(gauge, angle);
+#if GC9A01A_BAND_LINES
+    (void)from;
+    (void)half;
+    gc9a01a_draw_gauge(gauge, angle);
+#else
+    if (angle == from)
+        return;
+    gauge->angle = angle;
+    // only the needle and the end of the bar moved, between the two values
+    if (angle > from)
+    {
+        gc9a01a_gauge_paint(gauge, from - half, angle - half + gauge->needle);
+    } else
+    {
+        gc9a01a_gauge_paint(gauge, angle - half, from - half + gauge->needle);
+    }
+#endif
+}
@@ -0,0 +1,115 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_arc.h
+ * @author  Nabli Hatem
+ * @brief   This module fills arcs and ring segments row by row with integer
+ *          math, and draws gauges whose updates only repaint the part of
+ *          the scale that changed.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Definition to prevent recursive inclusion -------------------------------*/
+#ifndef GC9A01A_ARC_H
+#define GC9A01A_ARC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes --------------------------------------------------------------- */
+#include <stdint.h>
+
+#define GC9A01A_ARC_MAX_RADIUS 2047  ///< Largest outer radius, larger arcs are not drawn
+
+/**
+ * @brief Ring scale with a value drawn as a bar, a needle or both. Angles
+ *        are in degrees, clockwise from 12 o'clock. Fill in the fields up
+ *        to needle_color, the driver keeps angle.
+ */
+typedef struct
+{
+    int16_t x;              ///< x-cordinate of the center
+    int16_t y;              ///< y-cordinate of the center
+    int16_t inner;          ///< Inner radius of the scale
+    int16_t outer;          ///< Outer radius of the scale, up to GC9A01A_ARC_MAX_RADIUS
+    int16_t start;          ///< Angle of the lowest value
+    int16_t end;            ///< Angle of the highest value, start < end <= start + 360
+    uint16_t color;         ///< Color of the scale up to the value
+    uint16_t track;         ///< Color of the scale past the value
+    uint16_t bgcolor;       ///< Background the anti-aliased edges are blended into
+    uint8_t aa;             ///< 1 to anti-alias the round edges of the scale
+    uint8_t needle;         ///< Width of the needle in degrees, 0 for a bar only
+    uint16_t needle_color;  ///< Color of the needle
+    int16_t angle;          ///< Angle of the value last drawn
+} gc9a01a_gauge_t;
+
+/**
+ * @brief Fill the part of a ring from angle start clockwise to angle end.
+ *        It covers the pixels whose distance to the center is between
+ *        inner and outer and whose angle is at least start and less than
+ *        end, so arcs sharing an angle neither overlap nor leave a gap.
+ * @param x x-cordinate of the center.
+ * @param y y-cordinate of the center.
+ * @param inner the inner radius, 0 for a pie slice.
+ * @param outer the outer radius, up to GC9A01A_ARC_MAX_RADIUS.
+ * @param start the first angle in degrees, clockwise from 12 o'clock.
+ * @param end the angle where the arc stops, end >= start + 360 fills the
+ *        whole ring.
+ * @param color the color in RGB565 format.
+ * @retval None.
+ */
+void gc9a01a_fill_arc(int16_t x, int16_t y, int16_t inner, int16_t outer, int16_t start,
+                      int16_t end, uint16_t color);
+
+/**
+ * @brief Fill an arc like gc9a01a_fill_arc() with anti-aliased edges, the
+ *        pixels they cross are blended by the area they cover. Offscreen
+ *        builds blend into what was drawn before, the direct build into
+ *        the gc9a01a_set_background() color.
+ * @param x x-cordinate of the center.
+ * @param y y-cordinate of the center.
+ * @param inner the inner radius, 0 for a pie slice.
+ * @param outer the outer radius, up to GC9A01A_ARC_MAX_RADIUS.
+ * @param start the first angle in degrees, clockwise from 12 o'clock.
+ * @param end the angle where the arc stops.
+ * @param color the color in RGB565 format.
+ * @retval None.
+ */
+void gc9a01a_fill_arc_aa(int16_t x, int16_t y, int16_t inner, int16_t outer, int16_t start,
+                         int16_t end, uint16_t color);
+
+/**
+ * @brief Draw the whole scale of a gauge for a value.
+ * @param gauge the gauge, it must stay valid until gc9a01a_flush() in the
+ *        banded build.
+ * @param angle the angle of the value, clamped to the scale.
+ * @retval None.
+ */
+void gc9a01a_draw_gauge(gc9a01a_gauge_t *gauge, int16_t angle);
+
+/**
+ * @brief Move the value of a gauge drawn by gc9a01a_draw_gauge(), only the
+ *        sector between the old and the new needle or bar end is drawn.
+ *        The banded build repaints the whole scale, as frames must.
+ * @param gauge the gauge, it must stay valid until gc9a01a_flush() in the
+ *        banded build.
+ * @param angle the angle of the value, clamped to the scale.
+ * @retval None.
+ */
+void gc9a01a_update_gauge(gc9a01a_gauge_t *gauge, int16_t angle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GC9A01A_ARC_H */
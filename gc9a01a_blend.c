@@ -0,0 +1,284 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_blend.c
+ * @author  Nabli Hatem
+ * @brief   This module contains the alpha blend kernels and the blended
+ *          image blits.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#include "gc9a01a_blend.h"
+#include "gc9a01a_internal.h"
+#include <string.h>
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define GC9A01A_LITTLE_ENDIAN 1
+#else
+#define GC9A01A_LITTLE_ENDIAN 0
+#endif
+
+// the vector kernels swap bus-order pixels assuming a little-endian core
+#if GC9A01A_BLEND_SIMD && defined(__ARM_NEON) && GC9A01A_LITTLE_ENDIAN
+#define GC9A01A_BLEND_NEON 1
+#include <arm_neon.h>
+#elif GC9A01A_BLEND_SIMD && defined(__ARM_FEATURE_SIMD32) && GC9A01A_LITTLE_ENDIAN
+#define GC9A01A_BLEND_DSP 1
+#include <arm_acle.h>
+#elif GC9A01A_BLEND_SIMD && defined(__SSE2__) && GC9A01A_LITTLE_ENDIAN
+#define GC9A01A_BLEND_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#define GC9A01A_BLEND_CHUNK 32  ///< ARGB pixels converted before each blend
+
+/**
+ * Blend one pixel. Both colors are spread as 00000GGGGGG00000RRRRR000000BBBBB
+ * so that a single multiply scales the three channels.
+ */
+static inline uint16_t gc9a01a_blend_pixel(uint16_t fg, uint16_t bg, uint8_t alpha) {
+    uint32_t a = (alpha + 4) >> 3;
+    uint32_t f = (fg | ((uint32_t)fg << 16)) & 0x07E0F81F;
+    uint32_t b = (bg | ((uint32_t)bg << 16)) & 0x07E0F81F;
+    uint32_t r = (b + (((f - b) * a) >> 5)) & 0x07E0F81F;
+
+    return r | (r >> 16);
+}
+
+static void gc9a01a_blend_scalar(uint16_t *dst, const uint16_t *fg, uint16_t color,
+                                 const uint8_t *alpha, uint16_t count) {
+    uint16_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (fg != NULL)
+        { color = fg[i]; }
+        if (alpha[i] >= 252)
+        {
+            dst[i] = gc9a01a_to_bus(color);
+        } else if (alpha[i] >= 4)
+        { dst[i] = gc9a01a_to_bus(gc9a01a_blend_pixel(color, gc9a01a_to_bus(dst[i]), alpha[i])); }
+    }
+}
+
+#if GC9A01A_BLEND_DSP
+/**
+ * Blend one pixel with dual 16-bit multiply-accumulates: the foreground
+ * channel sits in the bottom half and the background one in the top half,
+ * weighted by w = a | (32 - a) << 16.
+ */
+static inline uint32_t gc9a01a_blend_dsp_pixel(uint32_t fg, uint32_t bg, uint32_t w) {
+    uint32_t v = (fg & 0xFFFF) | (bg << 16);
+    uint32_t r = (uint32_t)__smuad((int32_t)((v >> 11) & 0x001F001F), (int32_t)w) >> 5;
+    uint32_t g = (uint32_t)__smuad((int32_t)((v >> 5) & 0x003F003F), (int32_t)w) >> 5;
+    uint32_t b = (uint32_t)__smuad((int32_t)(v & 0x001F001F), (int32_t)w) >> 5;
+
+    return (r << 11) | (g << 5) | b;
+}
+
+static void gc9a01a_blend_dsp(uint16_t *dst, const uint16_t *fg, uint16_t color,
+                              const uint8_t *alpha, uint16_t count) {
+    uint32_t d, f, a0, a1, p0, p1;
+
+    f = color | ((uint32_t)color << 16);
+    for (; count >= 2; count -= 2, dst += 2, alpha += 2)
+    {
+        // two pixels per word, __rev16 swaps both from bus order
+        memcpy(&d, dst, 4);
+        d = __rev16(d);
+        if (fg != NULL)
+        {
+            memcpy(&f, fg, 4);
+            fg += 2;
+        }
+        a0 = (alpha[0] + 4) >> 3;
+        a1 = (alpha[1] + 4) >> 3;
+        p0 = gc9a01a_blend_dsp_pixel(f, d & 0xFFFF, a0 | ((32 - a0) << 16));
+        p1 = gc9a01a_blend_dsp_pixel(f >> 16, d >> 16, a1 | ((32 - a1) << 16));
+        d = __rev16(p0 | (p1 << 16));
+        memcpy(dst, &d, 4);
+    }
+    if (count > 0)
+    { gc9a01a_blend_scalar(dst, fg, color, alpha, count); }
+}
+#endif
+
+#if GC9A01A_BLEND_NEON
+static void gc9a01a_blend_neon(uint16_t *dst, const uint16_t *fg, uint16_t color,
+                               const uint8_t *alpha, uint16_t count) {
+    const uint16x8_t mask5 = vdupq_n_u16(0x1F), mask6 = vdupq_n_u16(0x3F);
+    uint16x8_t d, f, a, ia, r, g, b;
+
+    f = vdupq_n_u16(color);
+    for (; count >= 8; count -= 8, dst += 8, alpha += 8)
+    {
+        d = vreinterpretq_u16_u8(vrev16q_u8(vld1q_u8((const uint8_t *)dst)));
+        if (fg != NULL)
+        {
+            f = vld1q_u16(fg);
+            fg += 8;
+        }
+        a = vshrq_n_u16(vaddw_u8(vdupq_n_u16(4), vld1_u8(alpha)), 3);
+        ia = vsubq_u16(vdupq_n_u16(32), a);
+        r = vmlaq_u16(vmulq_u16(vshrq_n_u16(f, 11), a), vshrq_n_u16(d, 11), ia);
+        g = vmlaq_u16(vmulq_u16(vandq_u16(vshrq_n_u16(f, 5), mask6), a),
+                      vandq_u16(vshrq_n_u16(d, 5), mask6), ia);
+        b = vmlaq_u16(vmulq_u16(vandq_u16(f, mask5), a), vandq_u16(d, mask5), ia);
+        d = vorrq_u16(vshlq_n_u16(vshrq_n_u16(r, 5), 11),
+                      vorrq_u16(vshlq_n_u16(vshrq_n_u16(g, 5), 5), vshrq_n_u16(b, 5)));
+        vst1q_u8((uint8_t *)dst, vrev16q_u8(vreinterpretq_u8_u16(d)));
+    }
+    if (count > 0)
+    { gc9a01a_blend_scalar(dst, fg, color, alpha, count); }
+}
+#endif
+
+#if GC9A01A_BLEND_SSE2
+static void gc9a01a_blend_sse2(uint16_t *dst, const uint16_t *fg, uint16_t color,
+                               const uint8_t *alpha, uint16_t count) {
+    const __m128i mask5 = _mm_set1_epi16(0x1F), mask6 = _mm_set1_epi16(0x3F);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i d, f, a, ia, r, g, b;
+
+    f = _mm_set1_epi16((int16_t)color);
+    for (; count >= 8; count -= 8, dst += 8, alpha += 8)
+    {
+        d = _mm_loadu_si128((const __m128i *)dst);
+        d = _mm_or_si128(_mm_slli_epi16(d, 8), _mm_srli_epi16(d, 8));
+        if (fg != NULL)
+        {
+            f = _mm_loadu_si128((const __m128i *)fg);
+            fg += 8;
+        }
+        a = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)alpha), zero);
+        a = _mm_srli_epi16(_mm_add_epi16(a, _mm_set1_epi16(4)), 3);
+        ia = _mm_sub_epi16(_mm_set1_epi16(32), a);
+        r = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(f, 11), a),
+                          _mm_mullo_epi16(_mm_srli_epi16(d, 11), ia));
+        g = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(f, 5), mask6), a),
+                          _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(d, 5), mask6), ia));
+        b = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(f, mask5), a),
+                          _mm_mullo_epi16(_mm_and_si128(d, mask5), ia));
+        d = _mm_or_si128(_mm_slli_epi16(_mm_srli_epi16(r, 5), 11),
+                         _mm_or_si128(_mm_slli_epi16(_mm_srli_epi16(g, 5), 5),
+                                      _mm_srli_epi16(b, 5)));
+        d = _mm_or_si128(_mm_slli_epi16(d, 8), _mm_srli_epi16(d, 8));
+        _mm_storeu_si128((__m128i *)dst, d);
+    }
+    if (count > 0)
+    { gc9a01a_blend_scalar(dst, fg, color, alpha, count); }
+}
+#endif
+
+void gc9a01a_blend_span(uint16_t *dst, const uint16_t *fg, uint16_t color, const uint8_t *alpha,
+                        uint16_t count) {
+#if GC9A01A_BLEND_NEON
+    gc9a01a_blend_neon(dst, fg, color, alpha, count);
+#elif GC9A01A_BLEND_DSP
+    gc9a01a_blend_dsp(dst, fg, color, alpha, count);
+#elif GC9A01A_BLEND_SSE2
+    gc9a01a_blend_sse2(dst, fg, color, alpha, count);
+#else
+    gc9a01a_blend_scalar(dst, fg, color, alpha, count);
+#endif
+}
+
+const char *gc9a01a_blend_kernel(void) {
+#if GC9A01A_BLEND_NEON
+    return "neon";
+#elif GC9A01A_BLEND_DSP
+    return "dsp";
+#elif GC9A01A_BLEND_SSE2
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+static void gc9a01a_blend_mask(uint16_t *dst, const uint8_t *src, uint16_t count, uint16_t color) {
+    gc9a01a_blend_span(dst, NULL, color, src, count);
+}
+
+static void gc9a01a_blend_argb(uint16_t *dst, const uint8_t *src, uint16_t count, uint16_t color) {
+    const uint32_t *pixels = (const uint32_t *)src;
+    uint16_t fg[GC9A01A_BLEND_CHUNK];
+    uint8_t alpha[GC9A01A_BLEND_CHUNK];
+    uint16_t chunk, i;
+
+    (void)color;
+    while (count > 0)
+    {
+        chunk = (count > GC9A01A_BLEND_CHUNK) ? GC9A01A_BLEND_CHUNK : count;
+        for (i = 0; i < chunk; i++)
+        {
+            alpha[i] = pixels[i] >> 24;
+            fg[i] = ((pixels[i] >> 8) & 0xF800) | ((pixels[i] >> 5) & 0x07E0) |
+                    ((pixels[i] >> 3) & 0x001F);
+        }
+        gc9a01a_blend_span(dst, fg, 0, alpha, chunk);
+        pixels += chunk;
+        dst += chunk;
+        count -= chunk;
+    }
+}
+
+/**
+ * Blend the visible part of a width x height source of size bytes per
+ * pixel.
+ */
+static void gc9a01a_blend_image(int16_t x, int16_t y, int16_t width, int16_t height,
+                                const uint8_t *src, uint8_t size, gc9a01a_blend_fn blend,
+                                uint16_t color) {
+    int16_t c0, c1, r0, r1, r;
+
+    c0 = (x < 0) ? -x : 0;
+    r0 = (y < 0) ? -y : 0;
+    c1 = width - 1;
+    r1 = height - 1;
+    if (x + c1 >= GC9A01A_TFTWIDTH)
+    { c1 = GC9A01A_TFTWIDTH - 1 - x; }
+    if (y + r1 >= GC9A01A_TFTHEIGHT)
+    { r1 = GC9A01A_TFTHEIGHT - 1 - y; }
+    if ((c0 > c1) || (r0 > r1))
+    { return; }
+
+    gc9a01a_region_begin(x + c0, y + r0, x + c1, y + r1);
+    for (r = r0; r <= r1; r++)
+    { gc9a01a_region_blend(blend, src + ((uint32_t)r * width + c0) * size, size, c1 - c0 + 1, color); }
+    gc9a01a_region_end();
+}
+
+static void gc9a01a_alpha_mask_replay(const int16_t *args, uint16_t color, const void *data) {
+    gc9a01a_draw_alpha_mask(args[0], args[1], args[2], args[3], data, color);
+}
+
+static void gc9a01a_argb_image_replay(const int16_t *args, uint16_t color, const void *data) {
+    (void)color;
+    gc9a01a_draw_argb_image(args[0], args[1], args[2], args[3], data);
+}
+
+void gc9a01a_draw_alpha_mask(int16_t x, int16_t y, int16_t width, int16_t height,
+                             const uint8_t *mask, uint16_t color) {
+    const int16_t args[] = {x, y, width, height};
+
+    if (gc9a01a_record_call(gc9a01a_alpha_mask_replay, args, 4, color, mask))
+        return;
+    gc9a01a_blend_image(x, y, width, height, mask, 1, gc9a01a_blend_mask, color);
+}
+
+void gc9a01a_draw_argb_image(int16_t x, int16_t y, int16_t width, int16_t height,
+                             const uint32_t *image) {
+    const int16_t args[] = {x, y, width, height};
+
+    if (gc9a01a_record_call(gc9a01a_argb_image_replay, args, 4, 0, image))
+        return;
+    gc9a01a_blend_image(x, y, width, height, (const uint8_t *)image, 4, gc9a01a_blend_argb, 0);
+}
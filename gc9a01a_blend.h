@@ -0,0 +1,86 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_blend.h
+ * @author  Nabli Hatem
+ * @brief   This module draws alpha-blended images: A8 coverage masks in one
+ *          color and ARGB8888 images.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Definition to prevent recursive inclusion -------------------------------*/
+#ifndef GC9A01A_BLEND_H
+#define GC9A01A_BLEND_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes --------------------------------------------------------------- */
+#include <stdint.h>
+
+#ifndef GC9A01A_BLEND_SIMD
+#define GC9A01A_BLEND_SIMD 1  ///< Use the Cortex-M DSP, NEON or SSE2 kernel when the target has one
+#endif
+
+/**
+ * @brief Blend pixels into RGB565 pixels stored in bus order. Each channel
+ *        becomes (fg * a + bg * (32 - a)) / 32 with a = (alpha + 4) / 8,
+ *        every kernel gives the same result.
+ * @param dst count destination pixels in bus order, updated in place.
+ * @param fg count RGB565 source colors, or NULL to use color for all.
+ * @param color the source color when fg is NULL.
+ * @param alpha count opacities, 0 keeps dst and 255 replaces it.
+ * @param count number of pixels.
+ * @retval None.
+ */
+void gc9a01a_blend_span(uint16_t *dst, const uint16_t *fg, uint16_t color, const uint8_t *alpha,
+                        uint16_t count);
+
+/**
+ * @brief Name of the blend kernel selected at compile time.
+ * @retval "dsp", "neon", "sse2" or "scalar".
+ */
+const char *gc9a01a_blend_kernel(void);
+
+/**
+ * @brief Draw a color through an 8-bit coverage mask, for anti-aliased
+ *        icons and shapes. Offscreen builds blend into what was drawn
+ *        before, the direct build into the gc9a01a_set_background() color.
+ * @param x x-cordinate of the top left corner, may be off screen.
+ * @param y y-cordinate of the top left corner, may be off screen.
+ * @param width width of the mask.
+ * @param height height of the mask.
+ * @param mask width * height opacities.
+ * @param color the color in RGB565 format.
+ * @retval None.
+ */
+void gc9a01a_draw_alpha_mask(int16_t x, int16_t y, int16_t width, int16_t height,
+                             const uint8_t *mask, uint16_t color);
+
+/**
+ * @brief Draw a translucent image, blended like gc9a01a_draw_alpha_mask().
+ * @param x x-cordinate of the top left corner, may be off screen.
+ * @param y y-cordinate of the top left corner, may be off screen.
+ * @param width width of the image.
+ * @param height height of the image.
+ * @param image width * height pixels, 0xAARRGGBB.
+ * @retval None.
+ */
+void gc9a01a_draw_argb_image(int16_t x, int16_t y, int16_t width, int16_t height,
+                             const uint32_t *image);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GC9A01A_BLEND_H */
@@ -0,0 +1,756 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_font.c
+ * @author  Nabli Hatem
+ * @brief   This module contains the anti-aliased and proportional text
+ *          renderers.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#include "gc9a01a_font.h"
+#include "gc9a01a_glyph_cache.h"
+#include "gc9a01a_internal.h"
+#include <string.h>
+
+/**
+ * Colors of the 16 coverage levels between the background and the text
+ * color, in bus order. Text is usually drawn in few color pairs, so the
+ * table of the last pair is kept.
+ */
+static uint16_t blend_table[16];
+static uint16_t blend_color, blend_bgcolor;
+static uint8_t blend_valid = 0;
+
+static const uint16_t *gc9a01a_font_blend_table(uint16_t color, uint16_t bgcolor) {
+    uint16_t r, g, b;
+    uint8_t i;
+
+    if (blend_valid && (color == blend_color) && (bgcolor == blend_bgcolor))
+    { return blend_table; }
+    for (i = 0; i < 16; i++)
+    {
+        r = ((color >> 11) * i + (bgcolor >> 11) * (15 - i) + 7) / 15;
+        g = (((color >> 5) & 0x3F) * i + ((bgcolor >> 5) & 0x3F) * (15 - i) + 7) / 15;
+        b = ((color & 0x1F) * i + (bgcolor & 0x1F) * (15 - i) + 7) / 15;
+        blend_table[i] = gc9a01a_to_bus((r << 11) | (g << 5) | b);
+    }
+    blend_color = color;
+    blend_bgcolor = bgcolor;
+    blend_valid = 1;
+    return blend_table;
+}
+
+/**
+ * Distance between the blend table entries of two coverage levels, 2 bpp
+ * levels map to entries 0, 5, 10 and 15.
+ */
+static inline uint8_t gc9a01a_level_step(uint8_t bpp) {
+    return 15 / ((1 << bpp) - 1);
+}
+
+static inline const uint8_t *gc9a01a_aa_glyph(char ch, const gc9a01a_aa_font_t *font) {
+    uint8_t c = (uint8_t)ch;
+    uint32_t size = (uint32_t)((font->width * font->bpp + 7) / 8) * font->height;
+
+    if ((c < font->first) || (c > font->last))
+    { c = ((' ' >= font->first) && (' ' <= font->last)) ? ' ' : font->first; }
+    return font->data + (c - font->first) * size;
+}
+
+/**
+ * Expand a row of packed coverage levels into bus-order colors.
+ */
+static void gc9a01a_expand_row(uint16_t *out, const uint8_t *src, uint8_t width, uint8_t bpp,
+                               const uint16_t *table) {
+    const uint8_t mask = (1 << bpp) - 1;
+    const uint8_t step = gc9a01a_level_step(bpp);
+    int8_t shift = 8 - bpp;
+    uint8_t j;
+
+    for (j = 0; j < width; j++)
+    {
+        *out++ = table[((*src >> shift) & mask) * step];
+        shift -= bpp;
+        if (shift < 0)
+        {
+            shift = 8 - bpp;
+            src++;
+        }
+    }
+}
+
+/**
+ * Send a run of glyphs of the same text row through the open region, one
+ * pixel row of the whole run at a time.
+ */
+static void gc9a01a_write_aa_run(const char *str, uint16_t count, const gc9a01a_aa_font_t *font,
+                                 const uint16_t *table) {
+    uint16_t line[GC9A01A_TFTWIDTH];
+    const uint8_t stride = (font->width * font->bpp + 7) / 8;
+    uint16_t i, k;
+
+    for (i = 0; i < font->height; i++)
+    {
+        for (k = 0; k < count; k++)
+        {
+            gc9a01a_expand_row(&line[k * font->width], gc9a01a_aa_glyph(str[k], font) + i * stride,
+                               font->width, font->bpp, table);
+        }
+        gc9a01a_region_write_bus((const uint8_t *)line, count * font->width);
+    }
+}
+
+static void gc9a01a_aa_render(uint16_t *pixels, const void *data, uint32_t code, uint16_t color,
+                              uint16_t bgcolor) {
+    const gc9a01a_aa_font_t *font = data;
+    const uint16_t *table = gc9a01a_font_blend_table(color, bgcolor);
+    const uint8_t stride = (font->width * font->bpp + 7) / 8;
+    const uint8_t *src = gc9a01a_aa_glyph((char)code, font);
+    uint8_t i;
+
+    for (i = 0; i < font->height; i++)
+    { gc9a01a_expand_row(pixels + i * font->width, src + i * stride, font->width, font->bpp, table); }
+}
+
+/**
+ * Send a run of glyphs through the glyph cache, returns 0 when it is
+ * disabled or the glyphs do not fit in a slot.
+ */
+static uint8_t gc9a01a_write_aa_cached(const char *str, uint8_t count,
+                                       const gc9a01a_aa_font_t *font, uint16_t color,
+                                       uint16_t bgcolor) {
+    const uint8_t *glyphs[GC9A01A_GLYPH_RUN];
+    uint8_t widths[GC9A01A_GLYPH_RUN];
+    uint8_t k;
+
+    for (k = 0; k < count; k++)
+    {
+        glyphs[k] = gc9a01a_glyph_cache_get(font, (uint8_t)str[k], color, bgcolor,
+                                            font->width * font->height, gc9a01a_aa_render, font);
+        if (glyphs[k] == NULL)
+            return 0;
+        widths[k] = font->width;
+    }
+    gc9a01a_glyph_cache_write_run(glyphs, widths, count, font->height);
+    return 1;
+}
+
+/**
+ * Longest run of glyphs sent through the glyph cache, 0 when it is
+ * disabled. A run must not evict its own glyphs.
+ */
+static inline uint16_t gc9a01a_cached_run(void) {
+    uint16_t slots = gc9a01a_glyph_cache_slots();
+
+    return (slots > GC9A01A_GLYPH_RUN) ? GC9A01A_GLYPH_RUN : slots;
+}
+
+static void gc9a01a_aa_char_replay(const int16_t *args, uint16_t color, const void *data) {
+    gc9a01a_write_aa_char(args[0], args[1], (char)args[2], data, color, (uint16_t)args[3]);
+}
+
+static void gc9a01a_aa_string_replay(int16_t x, int16_t y, const char *str, const void *font,
+                                     uint16_t color, uint16_t bgcolor) {
+    gc9a01a_write_aa_string(x, y, str, font, color, bgcolor);
+}
+
+void gc9a01a_write_aa_char(int16_t x, int16_t y, char ch, const gc9a01a_aa_font_t *font,
+                           uint16_t color, uint16_t bgcolor) {
+    const int16_t args[] = {x, y, ch, (int16_t)bgcolor};
+    const uint8_t *cached;
+
+    if (gc9a01a_record_call(gc9a01a_aa_char_replay, args, 4, color, font))
+        return;
+    if ((x < 0) || (y < 0) || (x + font->width > GC9A01A_TFTWIDTH) ||
+        (y + font->height > GC9A01A_TFTHEIGHT))
+    { return; }
+    cached = gc9a01a_glyph_cache_get(font, (uint8_t)ch, color, bgcolor, font->width * font->height,
+                                     gc9a01a_aa_render, font);
+    gc9a01a_region_begin(x, y, x + font->width - 1, y + font->height - 1);
+    if (cached != NULL)
+    {
+        gc9a01a_region_send_bus(cached, font->width * font->height);
+    } else
+    {
+        gc9a01a_write_aa_run(&ch, 1, font, gc9a01a_font_blend_table(color, bgcolor));
+    }
+    gc9a01a_region_end();
+}
+
+void gc9a01a_write_aa_string(int16_t x, int16_t y, const char *str, const gc9a01a_aa_font_t *font,
+                             uint16_t color, uint16_t bgcolor) {
+    const uint16_t *table;
+    uint16_t run, cached_run;
+
+    if (gc9a01a_record_text(gc9a01a_aa_string_replay, x, y, str, font, color, bgcolor))
+        return;
+    if ((x < 0) || (y < 0) || (y + font->height > GC9A01A_TFTHEIGHT))
+    { return; }
+    table = gc9a01a_font_blend_table(color, bgcolor);
+    cached_run = gc9a01a_cached_run();
+    gc9a01a_begin_transaction();
+    while (*str)
+    {
+        if (x + font->width > GC9A01A_TFTWIDTH)
+        {
+            x = 0;
+            y += font->height;
+            if (y + font->height > GC9A01A_TFTHEIGHT)
+            { break; }
+
+            // skip
+            if (*str == ' ')
+            {
+                str++;
+                continue;
+            }
+        }
+
+        // batch every character that still fits on this row into one window
+        run = 0;
+        while (str[run] && (x + (run + 1) * font->width <= GC9A01A_TFTWIDTH))
+        { run++; }
+        if (cached_run && (run > cached_run))
+        { run = cached_run; }
+
+        gc9a01a_region_begin(x, y, x + run * font->width - 1, y + font->height - 1);
+        if (!cached_run || !gc9a01a_write_aa_cached(str, run, font, color, bgcolor))
+        { gc9a01a_write_aa_run(str, run, font, table); }
+        gc9a01a_region_end();
+        x += run * font->width;
+        str += run;
+    }
+    gc9a01a_end_transaction();
+}
+
+uint32_t gc9a01a_utf8_next(const char **str) {
+    static const uint32_t smallest[] = {0, 0x80, 0x800, 0x10000};
+    const uint8_t *s = (const uint8_t *)*str;
+    uint32_t code;
+    uint8_t extra, i;
+
+    if (s[0] < 0x80)
+    {
+        if (s[0])
+        { (*str)++; }
+        return s[0];
+    }
+    if ((s[0] & 0xE0) == 0xC0)
+    {
+        code = s[0] & 0x1F;
+        extra = 1;
+    } else if ((s[0] & 0xF0) == 0xE0)
+    {
+        code = s[0] & 0x0F;
+        extra = 2;
+    } else if ((s[0] & 0xF8) == 0xF0)
+    {
+        code = s[0] & 0x07;
+        extra = 3;
+    } else
+    {
+        (*str)++;
+        return 0xFFFD;
+    }
+    // a continuation byte never matches the terminating 0
+    for (i = 1; i <= extra; i++)
+    {
+        if ((s[i] & 0xC0) != 0x80)
+        {
+            (*str)++;
+            return 0xFFFD;
+        }
+        code = (code << 6) | (s[i] & 0x3F);
+    }
+    // overlong forms, surrogates and values past the last code point
+    if ((code < smallest[extra]) || (code > 0x10FFFF) || ((code >= 0xD800) && (code <= 0xDFFF)))
+    {
+        (*str)++;
+        return 0xFFFD;
+    }
+    *str += extra + 1;
+    return code;
+}
+
+const gc9a01a_glyph_t *gc9a01a_prop_glyph(const gc9a01a_prop_font_t *font, uint32_t code) {
+    const gc9a01a_code_range_t *r;
+    uint16_t lo = 0, hi = font->range_count, mid;
+
+    while (lo < hi)
+    {
+        mid = (lo + hi) / 2;
+        r = &font->ranges[mid];
+        if (code < r->first)
+        {
+            hi = mid;
+        } else if (code >= r->first + r->count)
+        {
+            lo = mid + 1;
+        } else
+        {
+            return &font->glyphs[r->glyph + (code - r->first)];
+        }
+    }
+    return &font->glyphs[font->fallback];
+}
+
+/**
+ * Expand one pixel row of a proportional glyph cell, the bitmap placed in
+ * it by its offsets.
+ */
+static void gc9a01a_prop_cell_row(uint16_t *out, const gc9a01a_glyph_t *g, uint8_t i,
+                                  const gc9a01a_prop_font_t *font, const uint16_t *table) {
+    const uint8_t mask = (1 << font->bpp) - 1;
+    const uint8_t step = gc9a01a_level_step(font->bpp);
+    const uint8_t *src;
+    uint16_t level;
+    int16_t row, cx;
+    int8_t shift;
+    uint8_t j;
+
+    for (j = 0; j < g->advance; j++)
+    { out[j] = table[0]; }
+    row = i - g->y_offset;
+    if ((row < 0) || (row >= g->height))
+        return;
+    src = font->bitmap + g->offset + row * ((g->width * font->bpp + 7) / 8);
+    shift = 8 - font->bpp;
+    for (j = 0; j < g->width; j++)
+    {
+        level = (*src >> shift) & mask;
+        cx = g->x_offset + j;
+        if (level && (cx >= 0) && (cx < g->advance))
+        { out[cx] = table[level * step]; }
+        shift -= font->bpp;
+        if (shift < 0)
+        {
+            shift = 8 - font->bpp;
+            src++;
+        }
+    }
+}
+
+/**
+ * Send a run of proportional glyphs of the same text row through the open
+ * region, one pixel row of the whole run at a time.
+ */
+static void gc9a01a_write_prop_run(const gc9a01a_glyph_t *const *glyphs, uint8_t count,
+                                   const gc9a01a_prop_font_t *font, const uint16_t *table) {
+    uint16_t line[GC9A01A_TFTWIDTH];
+    uint16_t n;
+    uint8_t i, k;
+
+    for (i = 0; i < font->height; i++)
+    {
+        n = 0;
+        for (k = 0; k < count; k++)
+        {
+            gc9a01a_prop_cell_row(&line[n], glyphs[k], i, font, table);
+            n += glyphs[k]->advance;
+        }
+        gc9a01a_region_write_bus((const uint8_t *)line, n);
+    }
+}
+
+static void gc9a01a_prop_render(uint16_t *pixels, const void *data, uint32_t code,
+                                uint16_t color, uint16_t bgcolor) {
+    const gc9a01a_prop_font_t *font = data;
+    const gc9a01a_glyph_t *g = gc9a01a_prop_glyph(font, code);
+    const uint16_t *table = gc9a01a_font_blend_table(color, bgcolor);
+    uint8_t i;
+
+    for (i = 0; i < font->height; i++)
+    { gc9a01a_prop_cell_row(pixels + i * g->advance, g, i, font, table); }
+}
+
+/**
+ * Send a run of proportional glyphs through the glyph cache, returns 0
+ * when it is disabled or the glyphs do not fit in a slot.
+ */
+static uint8_t gc9a01a_write_prop_cached(const uint32_t *codes, const gc9a01a_glyph_t *const *run,
+                                         uint8_t count, const gc9a01a_prop_font_t *font,
+                                         uint16_t color, uint16_t bgcolor) {
+    const uint8_t *glyphs[GC9A01A_GLYPH_RUN];
+    uint8_t widths[GC9A01A_GLYPH_RUN];
+    uint8_t k;
+
+    for (k = 0; k < count; k++)
+    {
+        glyphs[k] = gc9a01a_glyph_cache_get(font, codes[k], color, bgcolor,
+                                            run[k]->advance * font->height, gc9a01a_prop_render,
+                                            font);
+        if (glyphs[k] == NULL)
+            return 0;
+        widths[k] = run[k]->advance;
+    }
+    gc9a01a_glyph_cache_write_run(glyphs, widths, count, font->height);
+    return 1;
+}
+
+static void gc9a01a_prop_char_replay(const int16_t *args, uint16_t color, const void *data) {
+    gc9a01a_write_prop_char(args[0], args[1], ((uint32_t)(uint16_t)args[2] << 16) | (uint16_t)args[3],
+                            data, color, (uint16_t)args[4]);
+}
+
+static void gc9a01a_prop_string_replay(int16_t x, int16_t y, const char *str, const void *font,
+                                       uint16_t color, uint16_t bgcolor) {
+    gc9a01a_write_prop_string(x, y, str, font, color, bgcolor);
+}
+
+void gc9a01a_write_prop_char(int16_t x, int16_t y, uint32_t code, const gc9a01a_prop_font_t *font,
+                             uint16_t color, uint16_t bgcolor) {
+    const int16_t args[] = {x, y, (int16_t)(code >> 16), (int16_t)code, (int16_t)bgcolor};
+    const gc9a01a_glyph_t *g;
+    const uint8_t *cached;
+
+    if (gc9a01a_record_call(gc9a01a_prop_char_replay, args, 5, color, font))
+        return;
+    g = gc9a01a_prop_glyph(font, code);
+    if ((x < 0) || (y < 0) || (g->advance == 0) || (x + g->advance > GC9A01A_TFTWIDTH) ||
+        (y + font->height > GC9A01A_TFTHEIGHT))
+    { return; }
+    cached = gc9a01a_glyph_cache_get(font, code, color, bgcolor, g->advance * font->height,
+                                     gc9a01a_prop_render, font);
+    gc9a01a_region_begin(x, y, x + g->advance - 1, y + font->height - 1);
+    if (cached != NULL)
+    {
+        gc9a01a_region_send_bus(cached, g->advance * font->height);
+    } else
+    {
+        gc9a01a_write_prop_run(&g, 1, font, gc9a01a_font_blend_table(color, bgcolor));
+    }
+    gc9a01a_region_end();
+}
+
+void gc9a01a_write_prop_string(int16_t x, int16_t y, const char *str,
+                               const gc9a01a_prop_font_t *font, uint16_t color, uint16_t bgcolor) {
+    const gc9a01a_glyph_t *run[GC9A01A_PROP_RUN];
+    uint32_t codes[GC9A01A_PROP_RUN];
+    const gc9a01a_glyph_t *g;
+    const uint16_t *table;
+    uint32_t code;
+    uint16_t width, limit, cached_run;
+    uint8_t count;
+
+    if (gc9a01a_record_text(gc9a01a_prop_string_replay, x, y, str, font, color, bgcolor))
+        return;
+    if ((x < 0) || (y < 0) || (y + font->height > GC9A01A_TFTHEIGHT))
+    { return; }
+    table = gc9a01a_font_blend_table(color, bgcolor);
+    cached_run = gc9a01a_cached_run();
+    limit = (cached_run && (cached_run < GC9A01A_PROP_RUN)) ? cached_run : GC9A01A_PROP_RUN;
+    gc9a01a_begin_transaction();
+    code = gc9a01a_utf8_next(&str);
+    while (code)
+    {
+        g = gc9a01a_prop_glyph(font, code);
+        if (x + g->advance > GC9A01A_TFTWIDTH)
+        {
+            x = 0;
+            y += font->height;
+            if (y + font->height > GC9A01A_TFTHEIGHT)
+            { break; }
+
+            // skip
+            if (code == ' ')
+            {
+                code = gc9a01a_utf8_next(&str);
+                continue;
+            }
+        }
+
+        // batch the glyphs that still fit on this row into one window
+        count = 0;
+        width = 0;
+        while (code && (count < limit))
+        {
+            g = gc9a01a_prop_glyph(font, code);
+            if (x + width + g->advance > GC9A01A_TFTWIDTH)
+            { break; }
+            codes[count] = code;
+            run[count++] = g;
+            width += g->advance;
+            code = gc9a01a_utf8_next(&str);
+        }
+        // a glyph wider than the screen is dropped
+        if (count == 0)
+        {
+            code = gc9a01a_utf8_next(&str);
+            continue;
+        }
+        if (width > 0)
+        {
+            gc9a01a_region_begin(x, y, x + width - 1, y + font->height - 1);
+            if (!cached_run ||
+                !gc9a01a_write_prop_cached(codes, run, count, font, color, bgcolor))
+            { gc9a01a_write_prop_run(run, count, font, table); }
+            gc9a01a_region_end();
+            x += width;
+        }
+    }
+    gc9a01a_end_transaction();
+}
+
+const char *gc9a01a_get_prop_string_size(const char *str, glcd_font_size_t *size,
+                                         const gc9a01a_prop_font_t *font) {
+    const char *s = str;
+    uint32_t code;
+
+    size->height = font->height;
+    size->length = 0;
+    while ((code = gc9a01a_utf8_next(&s)) != 0)
+    { size->length += gc9a01a_prop_glyph(font, code)->advance; }
+    return str;
+}
+
+/**
+ * Visible columns of a line, the box columns on the panel and, for round
+ * layouts, on the glass for each of its pixel rows. Returns 0 when none.
+ */
+static uint16_t gc9a01a_text_span(int16_t x, uint16_t width, int16_t top, uint8_t height,
+                                  uint8_t flags, int16_t *x0) {
+    int16_t left = (x < 0) ? 0 : x;
+    int16_t right = x + (int16_t)width - 1;
+    uint8_t inset;
+    int16_t row;
+
+    if (right > GC9A01A_TFTWIDTH - 1)
+    { right = GC9A01A_TFTWIDTH - 1; }
+    if (flags & GC9A01A_TEXT_ROUND)
+    {
+        for (row = top; row < top + height; row++)
+        {
+            if ((row < 0) || (row >= GC9A01A_TFTHEIGHT))
+            {
+                *x0 = left;
+                return 0;
+            }
+            inset = gc9a01a_round_inset(row);
+            if (left < inset)
+            { left = inset; }
+            if (right > GC9A01A_TFTWIDTH - 1 - inset)
+            { right = GC9A01A_TFTWIDTH - 1 - inset; }
+        }
+    }
+    *x0 = left;
+    return (right >= left) ? right - left + 1 : 0;
+}
+
+/**
+ * Take the text of one line of limit pixels from s. The line ends at the
+ * last space that lets it fit, inside the word when there is none, and
+ * always takes a first glyph so that the text moves on. A first word that
+ * is only too long for this line of the glass, not for the box width
+ * whole, leaves the line empty instead. Returns the end of the line and in
+ * *next the start of the following one.
+ */
+static const char *gc9a01a_text_break(const char *s, const gc9a01a_prop_font_t *font,
+                                      uint16_t limit, uint16_t whole, uint16_t *width,
+                                      const char **next) {
+    const char *p = s, *q, *r, *end = s, *brk = NULL;
+    uint16_t w = 0, end_width = 0, brk_width = 0, word, advance;
+    uint32_t code;
+
+    for (;;)
+    {
+        q = p;
+        code = gc9a01a_utf8_next(&q);
+        if ((code == 0) || (code == '\n'))
+        {
+            *next = q;
+            if (code == 0)
+            { *next = p; }
+            *width = end_width;
+            return end;
+        }
+        advance = gc9a01a_prop_glyph(font, code)->advance;
+        if (code == ' ')
+        {
+            // a run of spaces after a word is where the line may break
+            if ((end == p) && (p != s))
+            {
+                brk = p;
+                brk_width = end_width;
+            }
+        } else if (w + advance > limit)
+        {
+            if (brk != NULL)
+            {
+                end = brk;
+                end_width = brk_width;
+            } else if (limit < whole)
+            {
+                // measure the rest of the word
+                r = q;
+                word = w + advance;
+                while (((code = gc9a01a_utf8_next(&r)) != 0) && (code != ' ') && (code != '\n'))
+                { word += gc9a01a_prop_glyph(font, code)->advance; }
+                if (word <= whole)
+                {
+                    *next = s;
+                    *width = 0;
+                    return s;
+                }
+            }
+            if ((brk == NULL) && (end == s))
+            {
+                end = q;
+                end_width = w + advance;
+            }
+            break;
+        }
+        w += advance;
+        p = q;
+        if (code != ' ')
+        {
+            end = p;
+            end_width = w;
+        }
+    }
+    // the spaces a line was broken at are not drawn
+    *next = end;
+    while (**next == ' ')
+    { (*next)++; }
+    *width = end_width;
+    return end;
+}
+
+/**
+ * Lay out up to lines lines from top, returns 1 when they take the whole
+ * string.
+ */
+static uint8_t gc9a01a_text_fill(gc9a01a_text_layout_t *layout, const char *str, int16_t x,
+                                 int16_t top, uint16_t width, uint8_t lines, uint8_t flags) {
+    const gc9a01a_prop_font_t *font = layout->font;
+    gc9a01a_text_line_t *line;
+    int16_t x0, right = 0;
+    uint16_t span, whole;
+
+    whole = gc9a01a_text_span(x, width, top, font->height, 0, &x0);
+
+    layout->x = GC9A01A_TFTWIDTH;
+    layout->y = top;
+    layout->count = 0;
+    while ((*str != 0) && (layout->count < lines))
+    {
+        line = &layout->lines[layout->count];
+        span = gc9a01a_text_span(x, width, top + layout->count * font->height, font->height,
+                                 flags, &x0);
+        line->start = str;
+        line->x = x0;
+        line->width = 0;
+        // lines off the glass stay empty
+        if (span > 0)
+        {
+            line->length =
+                gc9a01a_text_break(str, font, span, whole, &line->width, &str) - line->start;
+            if (line->width < span)
+            {
+                if ((flags & GC9A01A_TEXT_ALIGN) == GC9A01A_TEXT_CENTER)
+                {
+                    line->x += (span - line->width) / 2;
+                } else if ((flags & GC9A01A_TEXT_ALIGN) == GC9A01A_TEXT_RIGHT)
+                {
+                    line->x += span - line->width;
+                }
+            }
+        } else
+        {
+            line->length = 0;
+        }
+        if (line->width > 0)
+        {
+            if (line->x < layout->x)
+            { layout->x = line->x; }
+            if (line->x + line->width > right)
+            { right = line->x + line->width; }
+        }
+        layout->count++;
+    }
+    if (right > GC9A01A_TFTWIDTH)
+    { right = GC9A01A_TFTWIDTH; }
+    layout->width = (right > layout->x) ? right - layout->x : 0;
+    layout->height = layout->count * font->height;
+    return *str == 0;
+}
+
+uint8_t gc9a01a_text_layout(gc9a01a_text_layout_t *layout, const char *str,
+                            const gc9a01a_prop_font_t *font, int16_t x, int16_t y, uint16_t width,
+                            uint16_t height, uint8_t flags) {
+    uint16_t lines = height / font->height;
+    uint8_t n;
+
+    if (lines > GC9A01A_TEXT_LINES)
+    { lines = GC9A01A_TEXT_LINES; }
+    layout->font = font;
+    if (!(flags & GC9A01A_TEXT_MIDDLE))
+        return gc9a01a_text_fill(layout, str, x, y, width, lines, flags);
+
+    // on the round glass the width of a line depends on where the block
+    // is, so each line count is tried centered until the text fits
+    for (n = 1; n < lines; n++)
+    {
+        if (gc9a01a_text_fill(layout, str, x, y + (height - n * font->height) / 2, width, n,
+                              flags))
+        { return 1; }
+    }
+    return gc9a01a_text_fill(layout, str, x, y + (height - lines * font->height) / 2, width,
+                             lines, flags);
+}
+
+static void gc9a01a_text_layout_replay(const int16_t *args, uint16_t color, const void *data) {
+    gc9a01a_draw_text_layout(data, color, (uint16_t)args[0]);
+}
+
+void gc9a01a_draw_text_layout(const gc9a01a_text_layout_t *layout, uint16_t color,
+                              uint16_t bgcolor) {
+    const int16_t args[] = {(int16_t)bgcolor};
+    const gc9a01a_prop_font_t *font = layout->font;
+    uint16_t line[GC9A01A_TFTWIDTH];
+    const gc9a01a_text_line_t *l;
+    const gc9a01a_glyph_t *g;
+    const uint16_t *table;
+    const char *s;
+    int16_t row, y0, y1, pen;
+    uint16_t j;
+    uint8_t i;
+
+    if (gc9a01a_record_call(gc9a01a_text_layout_replay, args, 1, color, layout))
+        return;
+    y0 = (layout->y < 0) ? 0 : layout->y;
+    y1 = layout->y + (int16_t)layout->height - 1;
+    if (y1 > GC9A01A_TFTHEIGHT - 1)
+    { y1 = GC9A01A_TFTHEIGHT - 1; }
+    if ((layout->width == 0) || (y0 > y1))
+        return;
+    table = gc9a01a_font_blend_table(color, bgcolor);
+    gc9a01a_region_begin(layout->x, y0, layout->x + layout->width - 1, y1);
+    for (row = y0; row <= y1; row++)
+    {
+        l = &layout->lines[(row - layout->y) / font->height];
+        i = (row - layout->y) % font->height;
+        for (j = 0; j < layout->width; j++)
+        { line[j] = table[0]; }
+        s = l->start;
+        pen = l->x - layout->x;
+        while (s < l->start + l->length)
+        {
+            g = gc9a01a_prop_glyph(font, gc9a01a_utf8_next(&s));
+            // only a glyph wider than its line can cross the window
+            if (pen + g->advance <= layout->width)
+            { gc9a01a_prop_cell_row(&line[pen], g, i, font, table); }
+            pen += g->advance;
+        }
+        gc9a01a_region_write_bus((const uint8_t *)line, layout->width);
+    }
+    gc9a01a_region_end();
+}
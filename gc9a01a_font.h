@@ -0,0 +1,277 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_font.h
+ * @author  Nabli Hatem
+ * @brief   This module draws anti-aliased and proportional text with fonts
+ *          produced by tools/gc9a01a_font.py.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Definition to prevent recursive inclusion -------------------------------*/
+#ifndef GC9A01A_FONT_H
+#define GC9A01A_FONT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes --------------------------------------------------------------- */
+#include "glcdfont.h"
+#include <stdint.h>
+
+#ifndef GC9A01A_PROP_RUN
+#define GC9A01A_PROP_RUN 32  ///< Proportional glyphs sent per address window at most
+#endif
+
+/**
+ * @brief Fixed-cell anti-aliased font. Each glyph is height rows of
+ *        (width * bpp + 7) / 8 bytes, packing coverage levels most
+ *        significant bits first, 0 being the background and the highest
+ *        level the text color.
+ * @param width width of a character cell in pixels.
+ * @param height height of a character cell in pixels.
+ * @param bpp bits per pixel: 2 or 4.
+ * @param first character of the first glyph.
+ * @param last character of the last glyph.
+ * @param data the glyphs from first to last.
+ */
+typedef struct
+{
+    uint8_t width;
+    uint8_t height;
+    uint8_t bpp;
+    uint8_t first;
+    uint8_t last;
+    const uint8_t *data;
+} gc9a01a_aa_font_t;
+
+/**
+ * @brief Draw a character of an anti-aliased font. Characters without a
+ *        glyph are drawn as a space, or as the first glyph when the font
+ *        has no space.
+ * @param x x-cordinate of the top left corner.
+ * @param y y-cordinate of the top left corner.
+ * @param ch the character.
+ * @param font the font.
+ * @param color the text color in RGB565 format.
+ * @param bgcolor the background color in RGB565 format.
+ * @retval None.
+ */
+void gc9a01a_write_aa_char(int16_t x, int16_t y, char ch, const gc9a01a_aa_font_t *font,
+                           uint16_t color, uint16_t bgcolor);
+
+/**
+ * @brief Draw a string of an anti-aliased font, wrapping at the right edge
+ *        of the screen like gc9a01a_write_string().
+ * @param x x-cordinate of the top left corner.
+ * @param y y-cordinate of the top left corner.
+ * @param str the string.
+ * @param font the font.
+ * @param color the text color in RGB565 format.
+ * @param bgcolor the background color in RGB565 format.
+ * @retval None.
+ */
+void gc9a01a_write_aa_string(int16_t x, int16_t y, const char *str, const gc9a01a_aa_font_t *font,
+                             uint16_t color, uint16_t bgcolor);
+
+/**
+ * @brief Metrics of a proportional glyph. The bitmap is height rows of
+ *        (width * bpp + 7) / 8 bytes, packed like gc9a01a_aa_font_t glyphs.
+ */
+typedef struct
+{
+    uint32_t offset;   ///< Start of the bitmap in the font bitmap
+    uint8_t width;     ///< Bitmap width
+    uint8_t height;    ///< Bitmap height
+    uint8_t advance;   ///< Pen advance, the glyph cell is this wide
+    int8_t x_offset;   ///< Left of the bitmap from the pen position
+    int8_t y_offset;   ///< Top of the bitmap from the top of the line
+} gc9a01a_glyph_t;
+
+/**
+ * @brief Consecutive code points first..first + count - 1 have the glyphs
+ *        glyph..glyph + count - 1.
+ */
+typedef struct
+{
+    uint32_t first;  ///< First code point of the range
+    uint16_t count;  ///< Code points in the range
+    uint16_t glyph;  ///< Index of the glyph of first
+} gc9a01a_code_range_t;
+
+/**
+ * @brief Proportional font covering a sparse set of Unicode code points.
+ * @param height height of a line in pixels.
+ * @param baseline distance from the top of a line to the baseline.
+ * @param bpp bits per pixel: 1, 2 or 4.
+ * @param fallback index of the glyph drawn for code points not in the font.
+ * @param bitmap the glyph bitmaps.
+ * @param glyphs the glyph metrics.
+ * @param ranges the code point ranges, sorted by first.
+ * @param range_count number of ranges.
+ */
+typedef struct
+{
+    uint8_t height;
+    uint8_t baseline;
+    uint8_t bpp;
+    uint16_t fallback;
+    const uint8_t *bitmap;
+    const gc9a01a_glyph_t *glyphs;
+    const gc9a01a_code_range_t *ranges;
+    uint16_t range_count;
+} gc9a01a_prop_font_t;
+
+/**
+ * @brief Decode the next UTF-8 character of a string. Malformed sequences
+ *        decode as U+FFFD and skip a single byte.
+ * @param str the string, moved past the character.
+ * @retval the code point, 0 at the end of the string.
+ */
+uint32_t gc9a01a_utf8_next(const char **str);
+
+/**
+ * @brief Find the glyph of a code point.
+ * @param font the font.
+ * @param code the code point.
+ * @retval the glyph, the fallback glyph when the font does not have it.
+ */
+const gc9a01a_glyph_t *gc9a01a_prop_glyph(const gc9a01a_prop_font_t *font, uint32_t code);
+
+/**
+ * @brief Draw a character of a proportional font. The cell is the glyph
+ *        advance wide and the line height tall, pixels of the bitmap
+ *        outside of it are not drawn.
+ * @param x x-cordinate of the top left corner.
+ * @param y y-cordinate of the top left corner.
+ * @param code the Unicode code point.
+ * @param font the font.
+ * @param color the text color in RGB565 format.
+ * @param bgcolor the background color in RGB565 format.
+ * @retval None.
+ */
+void gc9a01a_write_prop_char(int16_t x, int16_t y, uint32_t code, const gc9a01a_prop_font_t *font,
+                             uint16_t color, uint16_t bgcolor);
+
+/**
+ * @brief Draw a UTF-8 string of a proportional font, wrapping at the right
+ *        edge of the screen like gc9a01a_write_string().
+ * @param x x-cordinate of the top left corner.
+ * @param y y-cordinate of the top left corner.
+ * @param str the UTF-8 string.
+ * @param font the font.
+ * @param color the text color in RGB565 format.
+ * @param bgcolor the background color in RGB565 format.
+ * @retval None.
+ */
+void gc9a01a_write_prop_string(int16_t x, int16_t y, const char *str,
+                               const gc9a01a_prop_font_t *font, uint16_t color, uint16_t bgcolor);
+
+/**
+ * @brief Measure a UTF-8 string of a proportional font on one line.
+ * @param str the UTF-8 string.
+ * @param size receives the line height and the sum of the advances, the
+ *        pixels gc9a01a_write_prop_string() draws when it does not wrap.
+ * @param font the font.
+ * @retval the string.
+ */
+const char *gc9a01a_get_prop_string_size(const char *str, glcd_font_size_t *size,
+                                         const gc9a01a_prop_font_t *font);
+
+#ifndef GC9A01A_TEXT_LINES
+#define GC9A01A_TEXT_LINES 8  ///< Lines of a text layout at most
+#endif
+
+#define GC9A01A_TEXT_LEFT 0x00    ///< Lines start at the left of their span
+#define GC9A01A_TEXT_CENTER 0x01  ///< Lines are centered in their span
+#define GC9A01A_TEXT_RIGHT 0x02   ///< Lines end at the right of their span
+#define GC9A01A_TEXT_ALIGN 0x03   ///< Mask of the horizontal alignment
+#define GC9A01A_TEXT_MIDDLE 0x04  ///< The lines are centered in the box height
+#define GC9A01A_TEXT_ROUND 0x08   ///< Lines are kept inside the round glass
+
+/**
+ * @brief A line of a text layout.
+ * @param start first byte of the line in the string.
+ * @param length bytes of the line, without the spaces it was broken at.
+ * @param x x-cordinate of the left of the line.
+ * @param width sum of the advances of the line.
+ */
+typedef struct
+{
+    const char *start;
+    uint16_t length;
+    int16_t x;
+    uint16_t width;
+} gc9a01a_text_line_t;
+
+/**
+ * @brief A string broken into lines by gc9a01a_text_layout(). The block
+ *        x, y, width and height enclose every line, it is the address
+ *        window gc9a01a_draw_text_layout() writes.
+ * @param font the font.
+ * @param x x-cordinate of the left of the block.
+ * @param y y-cordinate of the top of the first line.
+ * @param width width of the block, 0 when no line holds text.
+ * @param height count lines of the font height.
+ * @param count number of lines.
+ * @param lines the lines from top to bottom.
+ */
+typedef struct
+{
+    const gc9a01a_prop_font_t *font;
+    int16_t x;
+    int16_t y;
+    uint16_t width;
+    uint16_t height;
+    uint8_t count;
+    gc9a01a_text_line_t lines[GC9A01A_TEXT_LINES];
+} gc9a01a_text_layout_t;
+
+/**
+ * @brief Break a UTF-8 string into the lines of a box. Lines break between
+ *        words, inside a word only when it is longer than the line, and at
+ *        every '\n'. With GC9A01A_TEXT_ROUND each line is also kept inside
+ *        the visible part of the round glass for all of its pixel rows.
+ * @param layout receives the lines, it points into str.
+ * @param str the UTF-8 string.
+ * @param font the font.
+ * @param x x-cordinate of the top left corner of the box.
+ * @param y y-cordinate of the top left corner of the box.
+ * @param width width of the box.
+ * @param height height of the box.
+ * @param flags a GC9A01A_TEXT_ alignment, or-ed with GC9A01A_TEXT_MIDDLE
+ *        and GC9A01A_TEXT_ROUND.
+ * @retval 1 when the whole string fits in the box, 0 when it was cut.
+ */
+uint8_t gc9a01a_text_layout(gc9a01a_text_layout_t *layout, const char *str,
+                            const gc9a01a_prop_font_t *font, int16_t x, int16_t y, uint16_t width,
+                            uint16_t height, uint8_t flags);
+
+/**
+ * @brief Draw a text layout in a single address window, one pixel row of
+ *        every line at a time. The pixels of the window around the lines
+ *        are filled with the background color.
+ * @param layout the layout, it and its string must stay valid until
+ *        gc9a01a_flush() in the banded build.
+ * @param color the text color in RGB565 format.
+ * @param bgcolor the background color in RGB565 format.
+ * @retval None.
+ */
+void gc9a01a_draw_text_layout(const gc9a01a_text_layout_t *layout, uint16_t color,
+                              uint16_t bgcolor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GC9A01A_FONT_H */
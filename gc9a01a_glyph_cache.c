@@ -0,0 +1,163 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_glyph_cache.c
+ * @author  Nabli Hatem
+ * @brief   This module contains the glyph cache.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#include "gc9a01a_glyph_cache.h"
+#include "gc9a01a_internal.h"
+#include <string.h>
+
+#define GC9A01A_GLYPH_NONE 0xFFFF           ///< End of the LRU list
+#define GC9A01A_GLYPH_ALIGN sizeof(void *)  ///< Alignment of the entries, they hold a pointer
+
+typedef struct
+{
+    const void *font;
+    uint32_t code;
+    uint16_t color;
+    uint16_t bgcolor;
+    uint16_t prev;  ///< More recently used slot
+    uint16_t next;  ///< Less recently used slot
+} gc9a01a_glyph_entry_t;
+
+static gc9a01a_glyph_entry_t *entries = NULL;
+static uint8_t *slot_pixels = NULL;
+static uint32_t slot_size = 0;  ///< Bytes per slot
+static uint16_t head = GC9A01A_GLYPH_NONE, tail = GC9A01A_GLYPH_NONE;
+static gc9a01a_glyph_cache_stats_t stats;
+
+void gc9a01a_glyph_cache_init(void *arena, uint32_t size, uint16_t max_pixels) {
+    uintptr_t start = ((uintptr_t)arena + GC9A01A_GLYPH_ALIGN - 1) &
+                      ~(uintptr_t)(GC9A01A_GLYPH_ALIGN - 1);
+    uint32_t slots;
+
+    memset(&stats, 0, sizeof(stats));
+    head = tail = GC9A01A_GLYPH_NONE;
+    // slots stay word aligned for the bus
+    slot_size = (2 * (uint32_t)max_pixels + 3) & ~(uint32_t)3;
+    if ((arena == NULL) || (max_pixels == 0) || (size < start - (uintptr_t)arena))
+        return;
+    size -= start - (uintptr_t)arena;
+    slots = size / (sizeof(gc9a01a_glyph_entry_t) + slot_size);
+    if (slots >= GC9A01A_GLYPH_NONE)
+    { slots = GC9A01A_GLYPH_NONE - 1; }
+    // the entry size is a multiple of their alignment, so the slots that
+    // follow them start aligned as well
+    entries = (gc9a01a_glyph_entry_t *)start;
+    slot_pixels = (uint8_t *)(entries + slots);
+    stats.slots = slots;
+}
+
+void gc9a01a_glyph_cache_clear(void) {
+    head = tail = GC9A01A_GLYPH_NONE;
+    stats.used = 0;
+}
+
+void gc9a01a_get_glyph_cache_stats(gc9a01a_glyph_cache_stats_t *out) {
+    *out = stats;
+}
+
+uint16_t gc9a01a_glyph_cache_slots(void) {
+    return stats.slots;
+}
+
+static void gc9a01a_glyph_unlink(uint16_t i) {
+    if (entries[i].prev != GC9A01A_GLYPH_NONE)
+    {
+        entries[entries[i].prev].next = entries[i].next;
+    } else
+    {
+        head = entries[i].next;
+    }
+    if (entries[i].next != GC9A01A_GLYPH_NONE)
+    {
+        entries[entries[i].next].prev = entries[i].prev;
+    } else
+    {
+        tail = entries[i].prev;
+    }
+}
+
+static void gc9a01a_glyph_link_front(uint16_t i) {
+    entries[i].prev = GC9A01A_GLYPH_NONE;
+    entries[i].next = head;
+    if (head != GC9A01A_GLYPH_NONE)
+    { entries[head].prev = i; }
+    head = i;
+    if (tail == GC9A01A_GLYPH_NONE)
+    { tail = i; }
+}
+
+const uint8_t *gc9a01a_glyph_cache_get(const void *key, uint32_t code, uint16_t color,
+                                       uint16_t bgcolor, uint32_t count,
+                                       gc9a01a_glyph_render_fn render, const void *font) {
+    gc9a01a_glyph_entry_t *e;
+    uint16_t i;
+
+    if (stats.slots == 0)
+        return NULL;
+    if (2 * count > slot_size)
+    {
+        stats.uncached++;
+        return NULL;
+    }
+
+    // the list is kept most recent first, so hot glyphs are found early
+    for (i = head; i != GC9A01A_GLYPH_NONE; i = e->next)
+    {
+        e = &entries[i];
+        if ((e->code == code) && (e->font == key) && (e->color == color) &&
+            (e->bgcolor == bgcolor))
+        {
+            stats.hits++;
+            if (i != head)
+            {
+                gc9a01a_glyph_unlink(i);
+                gc9a01a_glyph_link_front(i);
+            }
+            return slot_pixels + i * slot_size;
+        }
+    }
+
+    stats.misses++;
+    if (stats.used < stats.slots)
+    {
+        i = stats.used++;
+    } else
+    {
+        i = tail;
+        gc9a01a_glyph_unlink(i);
+        stats.evictions++;
+    }
+    e = &entries[i];
+    e->font = key;
+    e->code = code;
+    e->color = color;
+    e->bgcolor = bgcolor;
+    gc9a01a_glyph_link_front(i);
+    render((uint16_t *)(slot_pixels + i * slot_size), font, code, color, bgcolor);
+    return slot_pixels + i * slot_size;
+}
+
+void gc9a01a_glyph_cache_write_run(const uint8_t *const *glyphs, const uint8_t *widths,
+                                   uint8_t count, uint8_t height) {
+    uint8_t i, k;
+
+    for (i = 0; i < height; i++)
+    {
+        for (k = 0; k < count; k++)
+        { gc9a01a_region_write_bus(glyphs[k] + 2 * i * widths[k], widths[k]); }
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_glyph_cache.h
+ * @author  Nabli Hatem
+ * @brief   This module keeps recently drawn glyphs expanded to RGB565 in bus
+ *          order, so drawing them again skips the font decoding.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Definition to prevent recursive inclusion -------------------------------*/
+#ifndef GC9A01A_GLYPH_CACHE_H
+#define GC9A01A_GLYPH_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes --------------------------------------------------------------- */
+#include <stdint.h>
+
+#ifndef GC9A01A_GLYPH_RUN
+#define GC9A01A_GLYPH_RUN 16  ///< Cached glyphs sent per address window at most
+#endif
+
+/**
+ * @brief Glyph cache counters since gc9a01a_glyph_cache_init().
+ * @param hits glyphs found in the cache.
+ * @param misses glyphs expanded into the cache.
+ * @param evictions least recently used glyphs dropped to make room.
+ * @param uncached glyphs larger than a slot, drawn without the cache.
+ * @param slots glyphs the arena holds.
+ * @param used slots holding a glyph.
+ */
+typedef struct
+{
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t uncached;
+    uint16_t slots;
+    uint16_t used;
+} gc9a01a_glyph_cache_stats_t;
+
+/**
+ * @brief Cache the glyphs drawn by the text functions, keyed by font,
+ *        character, color and background color. The arena is cut into
+ *        slots of max_pixels pixels, the least recently used glyph is
+ *        replaced when they are all taken.
+ * @param arena memory owned by the cache until it is initialized again,
+ *        NULL disables the cache. Its start is rounded up to pointer
+ *        alignment, so a few bytes may go unused.
+ * @param size size of the arena in bytes.
+ * @param max_pixels largest glyph cached, width * height, for example
+ *        7 * 10 for font_7_x_10.
+ * @retval None.
+ */
+void gc9a01a_glyph_cache_init(void *arena, uint32_t size, uint16_t max_pixels);
+
+/**
+ * @brief Drop every cached glyph, needed when the data of a font changes.
+ * @retval None.
+ */
+void gc9a01a_glyph_cache_clear(void);
+
+/**
+ * @brief Read the glyph cache counters, to size the arena.
+ * @param stats receives the counters.
+ * @retval None.
+ */
+void gc9a01a_get_glyph_cache_stats(gc9a01a_glyph_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GC9A01A_GLYPH_CACHE_H */
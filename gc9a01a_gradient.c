@@ -0,0 +1,398 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_gradient.c
+ * @author  Nabli Hatem
+ * @brief   This module contains the gradient and Gouraud-shaded fills.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#include "gc9a01a_gradient.h"
+#include "gc9a01a_internal.h"
+
+#define GC9A01A_T_ONE 0x10000  ///< Gradient position of color_1, positions are 16.16
+#define GC9A01A_T_LIMIT (1024L * GC9A01A_T_ONE)  ///< Row starts clamp, far past both colors
+
+/**
+ * Added to the 16 fraction bits of each channel before they are dropped: a
+ * 4x4 Bayer pattern when dithering, one half to round otherwise.
+ */
+static const uint16_t dither_matrix[5][4] = {
+    {0x0800, 0x8800, 0x2800, 0xA800},
+    {0xC800, 0x4800, 0xE800, 0x6800},
+    {0x3800, 0xB800, 0x1800, 0x9800},
+    {0xF800, 0x7800, 0xD800, 0x5800},
+    {0x8000, 0x8000, 0x8000, 0x8000},
+};
+
+static const int32_t channel_max[3] = {31L << 16, 63L << 16, 31L << 16};
+
+/**
+ * Gradient prepared for a fill, channels are RGB565 levels in 16.16.
+ */
+typedef struct
+{
+    const gc9a01a_gradient_t *g;
+    int32_t base[3];   ///< color_0 channels
+    int32_t delta[3];  ///< color_1 - color_0 channels, in levels
+    int64_t length2;   ///< Linear: squared length from point 0 to point 1
+    int32_t step;      ///< Linear: position change per column
+    uint32_t radius2;  ///< Radial: squared radius
+    uint32_t scale;    ///< Radial: position per 1/8 pixel of distance, in 1/256
+} gc9a01a_gradient_ctx_t;
+
+static inline const uint16_t *gc9a01a_dither_row(uint8_t dither, int16_t y) {
+    return dither_matrix[dither ? (y & 3) : 4];
+}
+
+static inline uint16_t gc9a01a_shade(int32_t r, int32_t g, int32_t b, uint16_t threshold) {
+    return gc9a01a_to_bus((((r + threshold) >> 16) << 11) | (((g + threshold) >> 16) << 5) |
+                          ((b + threshold) >> 16));
+}
+
+static void gc9a01a_gradient_prepare(gc9a01a_gradient_ctx_t *ctx, const gc9a01a_gradient_t *g) {
+    int32_t dx = g->x_1 - g->x_0, dy = g->y_1 - g->y_0;
+    uint16_t radius = (g->radius > 4095) ? 4095 : g->radius;
+
+    ctx->g = g;
+    ctx->base[0] = (int32_t)(g->color_0 >> 11) << 16;
+    ctx->base[1] = (int32_t)((g->color_0 >> 5) & 0x3F) << 16;
+    ctx->base[2] = (int32_t)(g->color_0 & 0x1F) << 16;
+    ctx->delta[0] = (g->color_1 >> 11) - (g->color_0 >> 11);
+    ctx->delta[1] = ((g->color_1 >> 5) & 0x3F) - ((g->color_0 >> 5) & 0x3F);
+    ctx->delta[2] = (g->color_1 & 0x1F) - (g->color_0 & 0x1F);
+    ctx->length2 = (int64_t)dx * dx + (int64_t)dy * dy;
+    ctx->step = (ctx->length2 != 0) ? (int32_t)((int64_t)dx * GC9A01A_T_ONE / ctx->length2) : 0;
+    ctx->radius2 = (uint32_t)radius * radius;
+    ctx->scale = (radius != 0) ? (8192UL << 8) / radius : 0;
+}
+
+static inline uint16_t gc9a01a_ramp(const gc9a01a_gradient_ctx_t *ctx, int32_t t,
+                                    uint16_t threshold) {
+    return gc9a01a_shade(ctx->base[0] + ctx->delta[0] * t, ctx->base[1] + ctx->delta[1] * t,
+                         ctx->base[2] + ctx->delta[2] * t, threshold);
+}
+
+/**
+ * Shade count pixels of row y from column x into out, in bus order. The
+ * position is 0 at color_0 and GC9A01A_T_ONE at color_1, clamped between
+ * the two.
+ */
+static void gc9a01a_gradient_row(uint16_t *out, const gc9a01a_gradient_ctx_t *ctx, int16_t x,
+                                 int16_t y, uint16_t count) {
+    const gc9a01a_gradient_t *g = ctx->g;
+    const uint16_t *threshold = gc9a01a_dither_row(g->dither, y);
+    int64_t num;
+    int32_t pos, dx;
+    uint32_t dy2, half, q = 0, d = 0;
+    uint16_t i;
+    uint8_t tracking = 0;
+
+    if (g->type == GC9A01A_GRADIENT_LINEAR)
+    {
+        pos = GC9A01A_T_ONE;
+        if (ctx->length2 != 0)
+        {
+            // one division per row, then the position steps along it
+            num = (int64_t)(x - g->x_0) * (g->x_1 - g->x_0) +
+                  (int64_t)(y - g->y_0) * (g->y_1 - g->y_0);
+            num = num * GC9A01A_T_ONE / ctx->length2;
+            pos = (num < -GC9A01A_T_LIMIT)  ? -GC9A01A_T_LIMIT
+                  : (num > GC9A01A_T_LIMIT) ? GC9A01A_T_LIMIT
+                                            : (int32_t)num;
+        }
+        for (i = 0; i < count; i++, pos += ctx->step)
+        {
+            out[i] = gc9a01a_ramp(ctx, (pos < 0) ? 0 : (pos > GC9A01A_T_ONE) ? GC9A01A_T_ONE : pos,
+                                  threshold[(x + i) & 3]);
+        }
+        return;
+    }
+
+    // radial: outside the radius the row is color_1, inside it the
+    // distance is tracked in 1/8 pixels as the column moves
+    dy2 = (uint32_t)((int32_t)y - g->y_0) * (uint32_t)((int32_t)y - g->y_0);
+    half = (dy2 < ctx->radius2) ? gc9a01a_isqrt(ctx->radius2 - dy2) : 0;
+    for (i = 0; i < count; i++)
+    {
+        dx = (int32_t)x + i - g->x_0;
+        if ((dy2 >= ctx->radius2) || (dx < -(int32_t)half) || (dx > (int32_t)half))
+        {
+            out[i] = gc9a01a_ramp(ctx, GC9A01A_T_ONE, threshold[(x + i) & 3]);
+            tracking = 0;
+            continue;
+        }
+        if (!tracking)
+        {
+            q = 64 * ((uint32_t)(dx * dx) + dy2);
+            d = gc9a01a_isqrt(q);
+            tracking = 1;
+        } else
+        {
+            q += 64 * (2 * dx - 1);
+            while ((d + 1) * (d + 1) <= q)
+            { d++; }
+            while (d * d > q)
+            { d--; }
+        }
+        pos = (d * ctx->scale) >> 8;
+        out[i] = gc9a01a_ramp(ctx, (pos > GC9A01A_T_ONE) ? GC9A01A_T_ONE : pos,
+                              threshold[(x + i) & 3]);
+    }
+}
+
+static void gc9a01a_gradient_rectangle_replay(const int16_t *args, uint16_t color,
+                                              const void *data) {
+    (void)color;
+    gc9a01a_fill_gradient_rectangle(args[0], args[1], args[2], args[3], data);
+}
+
+void gc9a01a_fill_gradient_rectangle(int16_t x, int16_t y, int16_t width, int16_t height,
+                                     const gc9a01a_gradient_t *gradient) {
+    const int16_t args[] = {x, y, width, height};
+    uint16_t line[GC9A01A_TFTWIDTH];
+    gc9a01a_gradient_ctx_t ctx;
+    int16_t x1 = x + width - 1, y1 = y + height - 1, row;
+
+    if (gc9a01a_record_call(gc9a01a_gradient_rectangle_replay, args, 4, 0, gradient))
+        return;
+    if (x < 0)
+    { x = 0; }
+    if (y < 0)
+    { y = 0; }
+    if (x1 > GC9A01A_TFTWIDTH - 1)
+    { x1 = GC9A01A_TFTWIDTH - 1; }
+    if (y1 > GC9A01A_TFTHEIGHT - 1)
+    { y1 = GC9A01A_TFTHEIGHT - 1; }
+    if ((width <= 0) || (height <= 0) || (x > x1) || (y > y1))
+    { return; }
+
+    gc9a01a_gradient_prepare(&ctx, gradient);
+    gc9a01a_region_begin(x, y, x1, y1);
+    for (row = y; row <= y1; row++)
+    {
+        gc9a01a_gradient_row(line, &ctx, x, row, x1 - x + 1);
+        gc9a01a_region_write_bus((const uint8_t *)line, x1 - x + 1);
+    }
+    gc9a01a_region_end();
+}
+
+static void gc9a01a_gradient_circle_replay(const int16_t *args, uint16_t color,
+                                           const void *data) {
+    (void)color;
+    gc9a01a_fill_gradient_circle(args[0], args[1], args[2], data);
+}
+
+/**
+ * Fill the columns x - half..x + half of row y, clipped to the screen.
+ */
+static void gc9a01a_gradient_span(const gc9a01a_gradient_ctx_t *ctx, int16_t x, int16_t y,
+                                  int16_t half) {
+    uint16_t line[GC9A01A_TFTWIDTH];
+    int16_t x0 = (x - half < 0) ? 0 : x - half;
+    int16_t x1 = (x + half > GC9A01A_TFTWIDTH - 1) ? GC9A01A_TFTWIDTH - 1 : x + half;
+
+    if ((y < 0) || (y >= GC9A01A_TFTHEIGHT) || (x0 > x1))
+        return;
+    gc9a01a_gradient_row(line, ctx, x0, y, x1 - x0 + 1);
+    gc9a01a_region_begin(x0, y, x1, y);
+    gc9a01a_region_write_bus((const uint8_t *)line, x1 - x0 + 1);
+    gc9a01a_region_end();
+}
+
+void gc9a01a_fill_gradient_circle(int16_t x, int16_t y, int16_t radius,
+                                  const gc9a01a_gradient_t *gradient) {
+    const int16_t args[] = {x, y, radius};
+    gc9a01a_gradient_ctx_t ctx;
+    int16_t xd = 0, yd = radius;
+    int16_t d = 1 - radius;
+
+    if (gc9a01a_record_call(gc9a01a_gradient_circle_replay, args, 3, 0, gradient))
+        return;
+    if (radius < 0)
+        return;
+    gc9a01a_gradient_prepare(&ctx, gradient);
+    gc9a01a_begin_transaction();
+    // the rows of gc9a01a_fill_circle(), each drawn once at its widest
+    while (yd >= xd)
+    {
+        gc9a01a_gradient_span(&ctx, x, y + xd, yd);
+        if (xd != 0)
+        { gc9a01a_gradient_span(&ctx, x, y - xd, yd); }
+        if (d < 0)
+        {
+            d += (2 * xd + 3);
+        } else
+        {
+            if (yd != xd)
+            {
+                gc9a01a_gradient_span(&ctx, x, y + yd, xd);
+                gc9a01a_gradient_span(&ctx, x, y - yd, xd);
+            }
+            --yd;
+            d += (2 * (xd - yd) + 3);
+        }
+        ++xd;
+    }
+    gc9a01a_end_transaction();
+}
+
+/**
+ * Channels of a Gouraud triangle, the plane through its three corner
+ * colors in 16.16 levels.
+ */
+typedef struct
+{
+    int16_t x_0, y_0;
+    int32_t base[3];     ///< Channels at (x_0, y_0)
+    int64_t per_x[3];    ///< Channel change per column
+    int64_t per_y[3];    ///< Channel change per row
+    int32_t step[3];     ///< per_x, bounded for the pixel loop
+    uint8_t dither;
+} gc9a01a_plane_t;
+
+static void gc9a01a_gouraud_rows(gc9a01a_edge_t *left, gc9a01a_edge_t *right, int16_t y,
+                                 int16_t y_end, const gc9a01a_plane_t *p) {
+    uint16_t line[GC9A01A_TFTWIDTH];
+    const uint16_t *threshold;
+    int32_t x0, x1, ch[3], i, k;
+    int64_t v;
+
+    for (; y < y_end; y++)
+    {
+        x0 = (left->x < 0) ? 0 : left->x;
+        x1 = (right->x > GC9A01A_TFTWIDTH) ? GC9A01A_TFTWIDTH : right->x;
+        if (x0 < x1)
+        {
+            threshold = gc9a01a_dither_row(p->dither, y);
+            for (k = 0; k < 3; k++)
+            {
+                v = p->base[k] + p->per_x[k] * (x0 - p->x_0) + p->per_y[k] * (y - p->y_0);
+                ch[k] = (v < 0) ? 0 : (v > channel_max[k]) ? channel_max[k] : (int32_t)v;
+            }
+            for (i = 0; i < x1 - x0; i++)
+            {
+                line[i] = gc9a01a_shade(ch[0], ch[1], ch[2], threshold[(x0 + i) & 3]);
+                // rounding can carry a step just past the corner colors
+                for (k = 0; k < 3; k++)
+                {
+                    ch[k] += p->step[k];
+                    if (ch[k] < 0)
+                    { ch[k] = 0; }
+                    if (ch[k] > channel_max[k])
+                    { ch[k] = channel_max[k]; }
+                }
+            }
+            gc9a01a_region_begin(x0, y, x1 - 1, y);
+            gc9a01a_region_write_bus((const uint8_t *)line, x1 - x0);
+            gc9a01a_region_end();
+        }
+        gc9a01a_edge_step(left);
+        gc9a01a_edge_step(right);
+    }
+}
+
+static void gc9a01a_gouraud_replay(const int16_t *args, uint16_t color, const void *data) {
+    (void)color;
+    gc9a01a_fill_gouraud_triangle(data, args[0]);
+}
+
+void gc9a01a_fill_gouraud_triangle(const gc9a01a_vertex_t *vertices, uint8_t dither) {
+    const int16_t args[] = {dither};
+    const gc9a01a_vertex_t *v0 = &vertices[0], *v1 = &vertices[1], *v2 = &vertices[2], *tmp;
+    gc9a01a_edge_t long_edge, short_edge;
+    gc9a01a_plane_t plane;
+    int32_t c0[3], c1[3], c2[3];
+    int64_t cross, d1, d2;
+    int16_t y, y_mid, y_end;
+    uint8_t k;
+
+    if (gc9a01a_record_call(gc9a01a_gouraud_replay, args, 1, 0, vertices))
+        return;
+    // sort by Y
+    if (v0->y > v1->y)
+    {
+        tmp = v0;
+        v0 = v1;
+        v1 = tmp;
+    }
+    if (v1->y > v2->y)
+    {
+        tmp = v1;
+        v1 = v2;
+        v2 = tmp;
+    }
+    if (v0->y > v1->y)
+    {
+        tmp = v0;
+        v0 = v1;
+        v1 = tmp;
+    }
+    cross = (int64_t)(v2->x - v0->x) * (v1->y - v0->y) - (int64_t)(v1->x - v0->x) * (v2->y - v0->y);
+    y = (v0->y < 0) ? 0 : v0->y;
+    y_end = (v2->y > GC9A01A_TFTHEIGHT) ? GC9A01A_TFTHEIGHT : v2->y;
+    if ((cross == 0) || (y >= y_end))
+    { return; }
+
+    // solve the color plane once, the rows then only add
+    c0[0] = v0->color >> 11;
+    c0[1] = (v0->color >> 5) & 0x3F;
+    c0[2] = v0->color & 0x1F;
+    c1[0] = v1->color >> 11;
+    c1[1] = (v1->color >> 5) & 0x3F;
+    c1[2] = v1->color & 0x1F;
+    c2[0] = v2->color >> 11;
+    c2[1] = (v2->color >> 5) & 0x3F;
+    c2[2] = v2->color & 0x1F;
+    plane.x_0 = v0->x;
+    plane.y_0 = v0->y;
+    plane.dither = dither;
+    for (k = 0; k < 3; k++)
+    {
+        d1 = c1[k] - c0[k];
+        d2 = c2[k] - c0[k];
+        plane.base[k] = c0[k] << 16;
+        plane.per_x[k] = -(d1 * (v2->y - v0->y) - d2 * (v1->y - v0->y)) * 65536 / cross;
+        plane.per_y[k] = -(d2 * (v1->x - v0->x) - d1 * (v2->x - v0->x)) * 65536 / cross;
+        // a span steeper than a whole channel holds one pixel at most
+        plane.step[k] = (plane.per_x[k] > channel_max[1])    ? channel_max[1]
+                        : (plane.per_x[k] < -channel_max[1]) ? -channel_max[1]
+                                                             : (int32_t)plane.per_x[k];
+    }
+
+    gc9a01a_begin_transaction();
+    gc9a01a_edge_init(&long_edge, v0->x, v0->y, v2->x, v2->y, y);
+    y_mid = (v1->y < y_end) ? v1->y : y_end;
+    if (y < y_mid)
+    {
+        gc9a01a_edge_init(&short_edge, v0->x, v0->y, v1->x, v1->y, y);
+        if (cross < 0)
+        {
+            gc9a01a_gouraud_rows(&long_edge, &short_edge, y, y_mid, &plane);
+        } else
+        {
+            gc9a01a_gouraud_rows(&short_edge, &long_edge, y, y_mid, &plane);
+        }
+        y = y_mid;
+    }
+    if (y < y_end)
+    {
+        gc9a01a_edge_init(&short_edge, v1->x, v1->y, v2->x, v2->y, y);
+        if (cross < 0)
+        {
+            gc9a01a_gouraud_rows(&long_edge, &short_edge, y, y_end, &plane);
+        } else
+        {
+            gc9a01a_gouraud_rows(&short_edge, &long_edge, y, y_end, &plane);
+        }
+    }
+    gc9a01a_end_transaction();
+}
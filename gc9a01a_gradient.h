@@ -0,0 +1,104 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_gradient.h
+ * @author  Nabli Hatem
+ * @brief   This module fills rectangles and circles with linear or radial
+ *          gradients and triangles with per-vertex colors, computed while
+ *          the pixels are sent.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Definition to prevent recursive inclusion -------------------------------*/
+#ifndef GC9A01A_GRADIENT_H
+#define GC9A01A_GRADIENT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes --------------------------------------------------------------- */
+#include <stdint.h>
+
+#define GC9A01A_GRADIENT_LINEAR 0  ///< Colors change along the line from point 0 to point 1
+#define GC9A01A_GRADIENT_RADIAL 1  ///< Colors change with the distance to point 0
+
+/**
+ * @brief Two-color gradient. A linear gradient is color_0 up to the line
+ *        through (x_0, y_0) perpendicular to the gradient, color_1 from the
+ *        one through (x_1, y_1), and blends the two in between. A radial
+ *        gradient is color_0 at (x_0, y_0) and reaches color_1 at radius.
+ */
+typedef struct
+{
+    uint8_t type;      ///< GC9A01A_GRADIENT_LINEAR or GC9A01A_GRADIENT_RADIAL
+    uint8_t dither;    ///< 1 to dither the blend to RGB565 with a 4x4 ordered pattern
+    int16_t x_0;       ///< Where color_0 is, the center of a radial gradient
+    int16_t y_0;       ///< Where color_0 is, the center of a radial gradient
+    int16_t x_1;       ///< Where color_1 is, linear gradients only
+    int16_t y_1;       ///< Where color_1 is, linear gradients only
+    uint16_t radius;   ///< Distance reaching color_1, radial gradients only, up to 4095
+    uint16_t color_0;  ///< First color in RGB565 format
+    uint16_t color_1;  ///< Second color in RGB565 format
+} gc9a01a_gradient_t;
+
+/**
+ * @brief Corner of a Gouraud-shaded triangle.
+ */
+typedef struct
+{
+    int16_t x;       ///< x-cordinate
+    int16_t y;       ///< y-cordinate
+    uint16_t color;  ///< Color at the corner in RGB565 format
+} gc9a01a_vertex_t;
+
+/**
+ * @brief Fill a rectangle with a gradient, in a single address window.
+ * @param x x-cordinate of the top left corner.
+ * @param y y-cordinate of the top left corner.
+ * @param width width of the rectangle.
+ * @param height height of the rectangle.
+ * @param gradient the gradient in screen coordinates, it must stay valid
+ *        until gc9a01a_flush() in the banded build.
+ * @retval None.
+ */
+void gc9a01a_fill_gradient_rectangle(int16_t x, int16_t y, int16_t width, int16_t height,
+                                     const gc9a01a_gradient_t *gradient);
+
+/**
+ * @brief Fill a circle with a gradient, it covers the pixels of
+ *        gc9a01a_fill_circle().
+ * @param x x-cordinate of the center.
+ * @param y y-cordinate of the center.
+ * @param radius the radius.
+ * @param gradient the gradient in screen coordinates, it must stay valid
+ *        until gc9a01a_flush() in the banded build.
+ * @retval None.
+ */
+void gc9a01a_fill_gradient_circle(int16_t x, int16_t y, int16_t radius,
+                                  const gc9a01a_gradient_t *gradient);
+
+/**
+ * @brief Fill a triangle blending the colors of its corners, with the
+ *        pixels and fill rule of gc9a01a_fill_triangle().
+ * @param vertices the three corners, they must stay valid until
+ *        gc9a01a_flush() in the banded build.
+ * @param dither 1 to dither the blend to RGB565 with a 4x4 ordered pattern.
+ * @retval None.
+ */
+void gc9a01a_fill_gouraud_triangle(const gc9a01a_vertex_t *vertices, uint8_t dither);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GC9A01A_GRADIENT_H */
@@ -0,0 +1,145 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_indexed.c
+ * @author  Nabli Hatem
+ * @brief   This module contains the palette-indexed image blits.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#include "gc9a01a_indexed.h"
+#include "gc9a01a_internal.h"
+#include <string.h>
+
+#define GC9A01A_INDEXED_CHUNK 32  ///< Pixels expanded before each copy to the bus
+
+static void gc9a01a_indexed_replay(const int16_t *args, uint16_t color, const void *data) {
+    (void)color;
+    gc9a01a_draw_indexed_image_transparent(args[0], args[1], data, args[2]);
+}
+
+/**
+ * Unpack count indexes of a row starting at column col.
+ */
+static void gc9a01a_indexed_unpack(const uint8_t *row, uint8_t bpp, uint16_t col, uint16_t count,
+                                   uint8_t *indexes) {
+    const uint8_t mask = (1 << bpp) - 1;
+    const uint8_t *src;
+    int8_t shift;
+
+    if (bpp == 8)
+    {
+        memcpy(indexes, row + col, count);
+        return;
+    }
+    src = row + ((col * bpp) >> 3);
+    shift = 8 - bpp - ((col * bpp) & 7);
+    while (count-- > 0)
+    {
+        *indexes++ = (*src >> shift) & mask;
+        shift -= bpp;
+        if (shift < 0)
+        {
+            shift = 8 - bpp;
+            src++;
+        }
+    }
+}
+
+/**
+ * Expand indexes through the bus-order palette into the open region.
+ */
+static void gc9a01a_indexed_span(const uint8_t *indexes, uint16_t count, const uint16_t *lut) {
+    uint16_t out[GC9A01A_INDEXED_CHUNK];
+    uint16_t chunk, i;
+
+    while (count > 0)
+    {
+        chunk = (count > GC9A01A_INDEXED_CHUNK) ? GC9A01A_INDEXED_CHUNK : count;
+        for (i = 0; i < chunk; i++)
+        { out[i] = lut[indexes[i]]; }
+        gc9a01a_region_write_bus((const uint8_t *)out, chunk);
+        indexes += chunk;
+        count -= chunk;
+    }
+}
+
+void gc9a01a_draw_indexed_image(int16_t x, int16_t y, const gc9a01a_indexed_image_t *image) {
+    gc9a01a_draw_indexed_image_transparent(x, y, image, GC9A01A_NO_TRANSPARENCY);
+}
+
+void gc9a01a_draw_indexed_image_transparent(int16_t x, int16_t y,
+                                            const gc9a01a_indexed_image_t *image,
+                                            int16_t transparent) {
+    const int16_t args[] = {x, y, transparent};
+    uint16_t lut[256];
+    uint8_t indexes[GC9A01A_TFTWIDTH];
+    const uint8_t *row;
+    uint32_t stride;
+    int16_t c0, c1, r0, r1, r;
+    uint16_t count, i, a;
+
+    if (gc9a01a_record_call(gc9a01a_indexed_replay, args, 3, 0, image))
+        return;
+
+    // visible columns and rows, relative to the image
+    c0 = (x < 0) ? -x : 0;
+    r0 = (y < 0) ? -y : 0;
+    c1 = image->width - 1;
+    r1 = image->height - 1;
+    if (x + c1 >= GC9A01A_TFTWIDTH)
+    { c1 = GC9A01A_TFTWIDTH - 1 - x; }
+    if (y + r1 >= GC9A01A_TFTHEIGHT)
+    { r1 = GC9A01A_TFTHEIGHT - 1 - y; }
+    if ((c0 > c1) || (r0 > r1))
+    { return; }
+
+    // the palette converted once, so each pixel costs a single load
+    for (i = 0; i < (1 << image->bpp); i++)
+    { lut[i] = gc9a01a_to_bus(image->palette[i]); }
+
+    stride = ((uint32_t)image->width * image->bpp + 7) / 8;
+    row = image->data + r0 * stride;
+    count = c1 - c0 + 1;
+    gc9a01a_begin_transaction();
+    if (transparent < 0)
+    {
+        gc9a01a_region_begin(x + c0, y + r0, x + c1, y + r1);
+        for (r = r0; r <= r1; r++, row += stride)
+        {
+            gc9a01a_indexed_unpack(row, image->bpp, c0, count, indexes);
+            gc9a01a_indexed_span(indexes, count, lut);
+        }
+        gc9a01a_region_end();
+    } else
+    {
+        for (r = r0; r <= r1; r++, row += stride)
+        {
+            gc9a01a_indexed_unpack(row, image->bpp, c0, count, indexes);
+            // one window per opaque run of the row
+            for (i = 0; i < count;)
+            {
+                while ((i < count) && (indexes[i] == transparent))
+                { i++; }
+                a = i;
+                while ((i < count) && (indexes[i] != transparent))
+                { i++; }
+                if (i > a)
+                {
+                    gc9a01a_region_begin(x + c0 + a, y + r, x + c0 + i - 1, y + r);
+                    gc9a01a_indexed_span(indexes + a, i - a, lut);
+                    gc9a01a_region_end();
+                }
+            }
+        }
+    }
+    gc9a01a_end_transaction();
+}
@@ -0,0 +1,79 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_indexed.h
+ * @author  Nabli Hatem
+ * @brief   This module draws palette-indexed images of 1, 2, 4 or 8 bits per
+ *          pixel, expanded to RGB565 while they are sent.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Definition to prevent recursive inclusion -------------------------------*/
+#ifndef GC9A01A_INDEXED_H
+#define GC9A01A_INDEXED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes --------------------------------------------------------------- */
+#include <stdint.h>
+
+#define GC9A01A_NO_TRANSPARENCY -1  ///< Transparent index value meaning every pixel is drawn
+
+/**
+ * @brief Indexed image. Each row starts on a byte boundary and packs its
+ *        pixels most significant bits first, so a row takes
+ *        (width * bpp + 7) / 8 bytes.
+ * @param width width of the image in pixels.
+ * @param height height of the image in pixels.
+ * @param bpp bits per pixel: 1, 2, 4 or 8.
+ * @param data the packed indexes.
+ * @param palette 1 << bpp RGB565 colors.
+ */
+typedef struct
+{
+    uint16_t width;
+    uint16_t height;
+    uint8_t bpp;
+    const uint8_t *data;
+    const uint16_t *palette;
+} gc9a01a_indexed_image_t;
+
+/**
+ * @brief Draw an indexed image.
+ * @param x x-cordinate of the top left corner, may be off screen.
+ * @param y y-cordinate of the top left corner, may be off screen.
+ * @param image the image.
+ * @retval None.
+ */
+void gc9a01a_draw_indexed_image(int16_t x, int16_t y, const gc9a01a_indexed_image_t *image);
+
+/**
+ * @brief Draw an indexed image leaving the pixels of one index untouched.
+ *        Each row is sent as one window per opaque run, so images with many
+ *        short gaps cost more than opaque ones.
+ * @param x x-cordinate of the top left corner, may be off screen.
+ * @param y y-cordinate of the top left corner, may be off screen.
+ * @param image the image.
+ * @param transparent the index not drawn, or GC9A01A_NO_TRANSPARENCY.
+ * @retval None.
+ */
+void gc9a01a_draw_indexed_image_transparent(int16_t x, int16_t y,
+                                            const gc9a01a_indexed_image_t *image,
+                                            int16_t transparent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GC9A01A_INDEXED_H */
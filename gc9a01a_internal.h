@@ -0,0 +1,323 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_internal.h
+ * @author  Nabli Hatem
+ * @brief   This module exposes the pixel region writer of the gc9a01a driver
+ *          to the optional drawing modules (compressed images, blending,
+ *          text...), it is not part of the public API.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Definition to prevent recursive inclusion -------------------------------*/
+#ifndef GC9A01A_INTERNAL_H
+#define GC9A01A_INTERNAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes --------------------------------------------------------------- */
+#include "gc9a01a.h"
+
+/**
+ * @brief Convert a color to the value whose in-memory bytes are the RGB565
+ *        big-endian pixel expected by the panel.
+ * @param color the color in RGB565 format.
+ * @retval the color in bus order.
+ */
+static inline uint16_t gc9a01a_to_bus(uint16_t color) {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return color;
+#else
+    return (color >> 8) | (color << 8);
+#endif
+}
+
+/**
+ * @brief Draw call replayed by the banded renderer.
+ * @param args the integer arguments given to gc9a01a_record_call().
+ * @param color the color given to gc9a01a_record_call().
+ * @param data the pointer given to gc9a01a_record_call().
+ */
+typedef void (*gc9a01a_replay_fn)(const int16_t *args, uint16_t color, const void *data);
+
+/**
+ * @brief Record a draw call when the banded renderer is collecting a frame.
+ * @param replay function drawing the call during gc9a01a_flush().
+ * @param args up to 6 integer arguments, copied.
+ * @param count number of args.
+ * @param color a color argument, copied.
+ * @param data a pointer argument, it must stay valid until the flush.
+ * @retval 1 when the call was recorded and must not draw now, 0 otherwise.
+ */
+uint8_t gc9a01a_record_call(gc9a01a_replay_fn replay, const int16_t *args, uint8_t count,
+                            uint16_t color, const void *data);
+
+/**
+ * @brief Text call replayed by the banded renderer.
+ * @param x the x given to gc9a01a_record_text().
+ * @param y the y given to gc9a01a_record_text().
+ * @param str a copy of the string given to gc9a01a_record_text().
+ * @param font the font given to gc9a01a_record_text().
+ * @param color the color given to gc9a01a_record_text().
+ * @param bgcolor the background color given to gc9a01a_record_text().
+ */
+typedef void (*gc9a01a_text_replay_fn)(int16_t x, int16_t y, const char *str, const void *font,
+                                       uint16_t color, uint16_t bgcolor);
+
+/**
+ * @brief Record a text call when the banded renderer is collecting a frame,
+ *        the string is copied.
+ * @param replay function drawing the text during gc9a01a_flush().
+ * @param x x-cordinate of the text.
+ * @param y y-cordinate of the text.
+ * @param str the string.
+ * @param font the font, it must stay valid until the flush.
+ * @param color the text color.
+ * @param bgcolor the background color.
+ * @retval 1 when the call was recorded and must not draw now, 0 otherwise.
+ */
+uint8_t gc9a01a_record_text(gc9a01a_text_replay_fn replay, int16_t x, int16_t y, const char *str,
+                            const void *font, uint16_t color, uint16_t bgcolor);
+
+/**
+ * @brief Restrict drawing to a rectangle, in the framebuffer and banded
+ *        builds only. In the banded build the clip rectangle in effect when
+ *        gc9a01a_flush() runs applies to the whole frame, and only its
+ *        pixels are sent.
+ * @param x0 first column.
+ * @param y0 first row.
+ * @param x1 last column.
+ * @param y1 last row.
+ * @retval None.
+ */
+void gc9a01a_set_clip(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
+/**
+ * @brief Let the primitives draw on the whole panel again.
+ * @retval None.
+ */
+void gc9a01a_reset_clip(void);
+
+/**
+ * @brief Open a transaction and a pixel region, the rectangle must lie on
+ *        the panel. Pixels are then written in row-major order.
+ * @param x0 first column.
+ * @param y0 first row.
+ * @param x1 last column.
+ * @param y1 last row.
+ * @retval None.
+ */
+void gc9a01a_region_begin(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+
+/**
+ * @brief Write RGB565 pixels into the open region.
+ * @param pixels the colors.
+ * @param count number of pixels.
+ * @retval None.
+ */
+void gc9a01a_region_write(const uint16_t *pixels, uint32_t count);
+
+/**
+ * @brief Write pixels already in bus order (RGB565 big-endian) into the
+ *        open region.
+ * @param data 2 * count bytes.
+ * @param count number of pixels.
+ * @retval None.
+ */
+void gc9a01a_region_write_bus(const uint8_t *data, uint32_t count);
+
+/**
+ * @brief Send pixels already in bus order into the open region from where
+ *        they are, in one transfer without going through the transmit
+ *        buffer. The offscreen builds copy them like
+ *        gc9a01a_region_write_bus().
+ * @param data 2 * count bytes, read before the function returns.
+ * @param count number of pixels.
+ * @retval None.
+ */
+void gc9a01a_region_send_bus(const uint8_t *data, uint32_t count);
+
+/**
+ * @brief Write count copies of a color into the open region.
+ * @param color the color in RGB565 format.
+ * @param count number of pixels.
+ * @retval None.
+ */
+void gc9a01a_region_repeat(uint16_t color, uint32_t count);
+
+/**
+ * @brief Mix source pixels into destination pixels.
+ * @param dst count pixels in bus order, updated in place.
+ * @param src the source of the first pixel.
+ * @param count number of pixels.
+ * @param color the color given to gc9a01a_region_blend().
+ */
+typedef void (*gc9a01a_blend_fn)(uint16_t *dst, const uint8_t *src, uint16_t count,
+                                 uint16_t color);
+
+/**
+ * @brief Blend count source pixels into the open region. Offscreen builds
+ *        blend into what was drawn before, the direct build into the
+ *        gc9a01a_set_background() color.
+ * @param blend the function mixing a span of the row.
+ * @param src source of the first pixel.
+ * @param size bytes per source pixel.
+ * @param count number of pixels.
+ * @param color passed to blend.
+ * @retval None.
+ */
+void gc9a01a_region_blend(gc9a01a_blend_fn blend, const uint8_t *src, uint8_t size,
+                          uint32_t count, uint16_t color);
+
+/**
+ * @brief Close the region opened by gc9a01a_region_begin() and its
+ *        transaction.
+ * @retval None.
+ */
+void gc9a01a_region_end(void);
+
+/**
+ * @brief Rectangle of the panel, inclusive bounds.
+ */
+typedef struct
+{
+    uint16_t x0, y0, x1, y1;
+} gc9a01a_rect_t;
+
+/**
+ * @brief Add a rectangle to a list of areas to redraw, in the framebuffer
+ *        and banded builds only. It absorbs every rectangle of the list
+ *        whose union with it costs at most a few clean pixels more than
+ *        both. When the list is full, the rectangle that grows least takes
+ *        it.
+ * @param rects the list.
+ * @param count number of rectangles in the list, updated.
+ * @param capacity size of the list, at least 1.
+ * @param rect the rectangle, it must lie on the panel.
+ * @retval None.
+ */
+void gc9a01a_rect_merge(gc9a01a_rect_t *rects, uint8_t *count, uint8_t capacity,
+                        const gc9a01a_rect_t *rect);
+
+/**
+ * @brief Integer square root.
+ * @param value the number.
+ * @retval the largest root whose square is at most value.
+ */
+uint32_t gc9a01a_isqrt(uint32_t value);
+
+/**
+ * @brief First visible column of a row of the round glass, the visible
+ *        span of row y is [inset, GC9A01A_TFTWIDTH - 1 - inset].
+ * @param y the row.
+ * @retval the inset.
+ */
+uint8_t gc9a01a_round_inset(uint16_t y);
+
+/**
+ * @brief Triangle edge stepped one row at a time with integers only. x is
+ *        the first column at or right of the edge on the current row, and
+ *        rem the distance from the edge to it in 1/dy of a pixel, in [0, dy).
+ */
+typedef struct
+{
+    int32_t x;
+    int32_t step;  ///< Whole columns the edge moves per row
+    int32_t frac;  ///< Remaining dx - step * dy, in [0, dy)
+    int32_t rem;
+    int32_t dy;
+} gc9a01a_edge_t;
+
+/**
+ * @brief Start an edge on row y. Filling each row from the left edge x up
+ *        to, not including, the right edge x is the top-left fill rule of
+ *        gc9a01a_fill_triangle().
+ * @param e the edge.
+ * @param x_0 x-cordinate of the upper end.
+ * @param y_0 y-cordinate of the upper end.
+ * @param x_1 x-cordinate of the lower end.
+ * @param y_1 y-cordinate of the lower end, greater than y_0.
+ * @param y the first row.
+ * @retval None.
+ */
+void gc9a01a_edge_init(gc9a01a_edge_t *e, int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_1,
+                       int16_t y);
+
+/**
+ * @brief Move an edge to the next row.
+ * @param e the edge.
+ * @retval None.
+ */
+static inline void gc9a01a_edge_step(gc9a01a_edge_t *e) {
+    e->x += e->step;
+    e->rem -= e->frac;
+    if (e->rem < 0)
+    {
+        e->x++;
+        e->rem += e->dy;
+    }
+}
+
+/**
+ * @brief Expand a glyph for the glyph cache.
+ * @param pixels receives the glyph in bus order, row after row.
+ * @param font the font given to gc9a01a_glyph_cache_get().
+ * @param code the character given to gc9a01a_glyph_cache_get().
+ * @param color the text color.
+ * @param bgcolor the background color.
+ */
+typedef void (*gc9a01a_glyph_render_fn)(uint16_t *pixels, const void *font, uint32_t code,
+                                        uint16_t color, uint16_t bgcolor);
+
+/**
+ * @brief Number of glyphs the glyph cache holds, 0 when it is disabled.
+ *        Glyphs of one run must not outnumber it, a later lookup of the
+ *        run would otherwise evict an earlier one.
+ * @retval the number of slots.
+ */
+uint16_t gc9a01a_glyph_cache_slots(void);
+
+/**
+ * @brief Find a glyph in the glyph cache, expanding it on a miss.
+ * @param key identifies the font, stable across calls.
+ * @param code the character.
+ * @param color the text color.
+ * @param bgcolor the background color.
+ * @param count pixels of the glyph.
+ * @param render expands the glyph on a miss.
+ * @param font passed to render.
+ * @retval the glyph in bus order, valid until the next lookup evicts it, or
+ *         NULL when the cache is disabled or the glyph too large.
+ */
+const uint8_t *gc9a01a_glyph_cache_get(const void *key, uint32_t code, uint16_t color,
+                                       uint16_t bgcolor, uint32_t count,
+                                       gc9a01a_glyph_render_fn render, const void *font);
+
+/**
+ * @brief Write a run of cached glyphs sharing a text row into the open
+ *        region, one pixel row of every glyph at a time.
+ * @param glyphs the glyphs returned by gc9a01a_glyph_cache_get().
+ * @param widths the width of each glyph.
+ * @param count number of glyphs.
+ * @param height height of the glyphs.
+ * @retval None.
+ */
+void gc9a01a_glyph_cache_write_run(const uint8_t *const *glyphs, const uint8_t *widths,
+                                   uint8_t count, uint8_t height);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GC9A01A_INTERNAL_H */
@@ -0,0 +1,113 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_memory.c
+ * @author  Nabli Hatem
+ * @brief   This module contains the implementation of the in-memory bus
+ *          backend of the gc9a01a driver.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "gc9a01a_memory.h"
+#include <stddef.h>
+#include <string.h>
+
+static gc9a01a_memory_counters_t counters;
+static uint8_t *log_buf = NULL;
+static uint32_t log_size = 0;
+static uint32_t log_len = 0;
+
+static void gc9a01a_memory_log(const uint8_t *data, uint32_t size) {
+    uint32_t room;
+
+    if (log_buf == NULL)
+        return;
+    room = log_size - log_len;
+    if (size > room)
+    { size = room; }
+    memcpy(&log_buf[log_len], data, size);
+    log_len += size;
+}
+
+static void gc9a01a_memory_set_cs(uint8_t level) {
+    if (level == 0)
+    { counters.selects++; }
+}
+
+static void gc9a01a_memory_set_dc(uint8_t level) {
+    (void)level;
+    counters.dc_toggles++;
+}
+
+static void gc9a01a_memory_set_rst(uint8_t level) {
+    (void)level;
+}
+
+static void gc9a01a_memory_delay_ms(uint32_t ms) {
+    counters.delay_ms += ms;
+}
+
+static void gc9a01a_memory_write_command(uint8_t cmd) {
+    counters.commands++;
+    counters.writes++;
+    gc9a01a_memory_log(&cmd, 1);
+}
+
+static void gc9a01a_memory_write_data(const uint8_t *data, uint32_t size) {
+    counters.data_bytes += size;
+    counters.writes++;
+    gc9a01a_memory_log(data, size);
+}
+
+static void gc9a01a_memory_write_data_async(const uint8_t *data, uint32_t size) {
+    gc9a01a_memory_write_data(data, size);
+    gc9a01a_transport_tx_complete();
+}
+
+static void gc9a01a_memory_write_color(uint16_t color, uint32_t count) {
+    uint8_t pixel[2] = {color >> 8, color & 0xFF};
+
+    counters.data_bytes += 2 * count;
+    counters.writes++;
+    while ((count-- > 0) && (log_buf != NULL) && (log_len < log_size))
+    { gc9a01a_memory_log(pixel, 2); }
+}
+
+void gc9a01a_memory_attach_log(uint8_t *log, uint32_t size) {
+    log_buf = log;
+    log_size = (log != NULL) ? size : 0;
+    log_len = 0;
+}
+
+uint32_t gc9a01a_memory_log_size(void) {
+    return log_len;
+}
+
+void gc9a01a_memory_get_counters(gc9a01a_memory_counters_t *out) {
+    *out = counters;
+}
+
+void gc9a01a_memory_reset(void) {
+    memset(&counters, 0, sizeof(counters));
+    log_len = 0;
+}
+
+const gc9a01a_transport_t gc9a01a_memory_transport = {
+    .set_cs = gc9a01a_memory_set_cs,
+    .set_dc = gc9a01a_memory_set_dc,
+    .set_rst = gc9a01a_memory_set_rst,
+    .delay_ms = gc9a01a_memory_delay_ms,
+    .write_command = gc9a01a_memory_write_command,
+    .write_data = gc9a01a_memory_write_data,
+    .write_data_async = gc9a01a_memory_write_data_async,
+    .write_color = gc9a01a_memory_write_color,
+};
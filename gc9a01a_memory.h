@@ -0,0 +1,89 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_memory.h
+ * @author  Nabli Hatem
+ * @brief   This module contains an in-memory bus backend of the gc9a01a
+ *          driver that records the traffic instead of driving a panel, to
+ *          profile the driver on a workstation.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Definition to prevent recursive inclusion -------------------------------*/
+#ifndef GC9A01A_MEMORY_H
+#define GC9A01A_MEMORY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes --------------------------------------------------------------- */
+#include "gc9a01a_transport.h"
+
+/**
+ * @brief Traffic seen by the in-memory bus.
+ * @param selects number of times CS went low.
+ * @param dc_toggles number of D/C level changes.
+ * @param commands number of command bytes.
+ * @param data_bytes number of parameter and pixel bytes.
+ * @param writes number of write_command/write_data/write_color calls.
+ * @param delay_ms total time asked through delay_ms.
+ */
+typedef struct
+{
+    uint32_t selects;
+    uint32_t dc_toggles;
+    uint32_t commands;
+    uint32_t data_bytes;
+    uint32_t writes;
+    uint32_t delay_ms;
+} gc9a01a_memory_counters_t;
+
+/**
+ * @brief Record every byte sent on the bus, commands and data interleaved,
+ *        into a user buffer. Bytes past the end of the buffer are counted
+ *        but dropped.
+ * @param log the buffer, NULL to stop recording.
+ * @param size the size of the buffer in bytes.
+ * @retval None.
+ */
+void gc9a01a_memory_attach_log(uint8_t *log, uint32_t size);
+
+/**
+ * @brief Number of bytes stored in the log since it was attached or reset.
+ * @retval the number of bytes.
+ */
+uint32_t gc9a01a_memory_log_size(void);
+
+/**
+ * @brief Read the traffic counters.
+ * @param counters where to copy the counters.
+ * @retval None.
+ */
+void gc9a01a_memory_get_counters(gc9a01a_memory_counters_t *counters);
+
+/**
+ * @brief Clear the traffic counters and rewind the log.
+ * @retval None.
+ */
+void gc9a01a_memory_reset(void);
+
+/**
+ * @brief In-memory bus, completes asynchronous writes immediately.
+ */
+extern const gc9a01a_transport_t gc9a01a_memory_transport;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GC9A01A_MEMORY_H */
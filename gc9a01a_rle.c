@@ -0,0 +1,97 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_rle.c
+ * @author  Nabli Hatem
+ * @brief   This module contains the streaming decoder of run-length
+ *          compressed RGB565 images.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#include "gc9a01a_rle.h"
+#include "gc9a01a_internal.h"
+
+static void gc9a01a_rle_replay(const int16_t *args, uint16_t color, const void *data) {
+    (void)color;
+    gc9a01a_draw_rle_image(args[0], args[1], data);
+}
+
+void gc9a01a_draw_rle_image(int16_t x, int16_t y, const gc9a01a_rle_image_t *image) {
+    const int16_t args[] = {x, y};
+    const uint8_t *p = image->data;
+    const uint8_t *end = image->data + image->size;
+    const uint8_t *literal = NULL;
+    int16_t c0, c1, r0, r1, a, b;
+    uint16_t col = 0, row = 0, count, n, color = 0;
+    uint8_t run;
+
+    if (gc9a01a_record_call(gc9a01a_rle_replay, args, 2, 0, image))
+        return;
+
+    // visible columns and rows, relative to the image
+    c0 = (x < 0) ? -x : 0;
+    r0 = (y < 0) ? -y : 0;
+    c1 = image->width - 1;
+    r1 = image->height - 1;
+    if (x + c1 >= GC9A01A_TFTWIDTH)
+    { c1 = GC9A01A_TFTWIDTH - 1 - x; }
+    if (y + r1 >= GC9A01A_TFTHEIGHT)
+    { r1 = GC9A01A_TFTHEIGHT - 1 - y; }
+    if ((c0 > c1) || (r0 > r1))
+    { return; }
+
+    gc9a01a_region_begin(x + c0, y + r0, x + c1, y + r1);
+    while ((p < end) && (row <= r1))
+    {
+        run = *p & GC9A01A_RLE_RUN;
+        count = (*p++ & 0x7F) + 1;
+        if (run)
+        {
+            color = (p[0] << 8) | p[1];
+            p += 2;
+        } else
+        {
+            literal = p;
+            p += 2 * count;
+        }
+
+        // split the packet at row ends and keep the visible part of each row
+        while (count > 0)
+        {
+            n = image->width - col;
+            if (n > count)
+            { n = count; }
+            if ((row >= r0) && (row <= r1))
+            {
+                a = (col > c0) ? col : c0;
+                b = (col + n - 1 < c1) ? col + n - 1 : c1;
+                if (a <= b)
+                {
+                    if (run)
+                    {
+                        gc9a01a_region_repeat(color, b - a + 1);
+                    } else
+                    { gc9a01a_region_write_bus(literal + 2 * (a - col), b - a + 1); }
+                }
+            }
+            if (!run)
+            { literal += 2 * n; }
+            col += n;
+            count -= n;
+            if (col == image->width)
+            {
+                col = 0;
+                row++;
+            }
+        }
+    }
+    gc9a01a_region_end();
+}
@@ -0,0 +1,67 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_rle.h
+ * @author  Nabli Hatem
+ * @brief   This module draws run-length compressed RGB565 images produced by
+ *          tools/gc9a01a_rle.py.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Definition to prevent recursive inclusion -------------------------------*/
+#ifndef GC9A01A_RLE_H
+#define GC9A01A_RLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes --------------------------------------------------------------- */
+#include <stdint.h>
+
+#define GC9A01A_RLE_RUN 0x80  ///< Packet flag: one pixel repeated instead of literal pixels
+
+/**
+ * @brief Compressed image. The data is a sequence of packets covering the
+ *        pixels in row-major order, a packet may span several rows. Each
+ *        packet starts with a control byte c, the low 7 bits hold the pixel
+ *        count minus one. If c has GC9A01A_RLE_RUN set, one RGB565
+ *        big-endian pixel follows and is repeated. Otherwise count
+ *        big-endian pixels follow.
+ * @param width width of the image in pixels.
+ * @param height height of the image in pixels.
+ * @param size number of bytes of data.
+ * @param data the packets.
+ */
+typedef struct
+{
+    uint16_t width;
+    uint16_t height;
+    uint32_t size;
+    const uint8_t *data;
+} gc9a01a_rle_image_t;
+
+/**
+ * @brief Draw a compressed image, runs are sent as repeated-color bursts and
+ *        literal pixels are copied to the bus as they are stored.
+ * @param x x-cordinate of the top left corner, may be off screen.
+ * @param y y-cordinate of the top left corner, may be off screen.
+ * @param image the compressed image.
+ * @retval None.
+ */
+void gc9a01a_draw_rle_image(int16_t x, int16_t y, const gc9a01a_rle_image_t *image);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GC9A01A_RLE_H */
@@ -0,0 +1,244 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_spidev.c
+ * @author  Nabli Hatem
+ * @brief   This module contains the implementation of the Linux spidev bus
+ *          backend of the gc9a01a driver.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#ifdef __linux__
+
+#define _POSIX_C_SOURCE 200809L  ///< nanosleep() with -std=c11
+
+#include "gc9a01a_spidev.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <linux/spi/spidev.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#define GC9A01A_SPIDEV_CHUNK 4096  ///< Default spidev bufsiz, larger writes are split
+
+static int spi_fd = -1;
+static int dc_fd = -1;
+static int rst_fd = -1;
+static int cs_fd = -1;
+static uint32_t speed_hz;
+
+/**
+ * The worker thread plays the role of the DMA: it runs one asynchronous write
+ * at a time and reports its end with the "interrupt" lock held, the driver
+ * takes the same lock in enter_critical.
+ */
+static pthread_t worker;
+static pthread_mutex_t irq_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t job_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t job_cond = PTHREAD_COND_INITIALIZER;
+static const uint8_t *job_data;
+static uint32_t job_size;
+static uint8_t job_pending = 0;
+static uint8_t worker_running = 0;
+
+static int gc9a01a_spidev_request_line(int chip_fd, int32_t line) {
+    struct gpiohandle_request request;
+
+    if (line < 0)
+        return -1;
+    memset(&request, 0, sizeof(request));
+    request.lineoffsets[0] = line;
+    request.lines = 1;
+    request.flags = GPIOHANDLE_REQUEST_OUTPUT;
+    request.default_values[0] = 1;
+    strncpy(request.consumer_label, "gc9a01a", sizeof(request.consumer_label) - 1);
+    if (ioctl(chip_fd, GPIO_GET_LINEHANDLE_IOCTL, &request) < 0)
+        return -1;
+    return request.fd;
+}
+
+static void gc9a01a_spidev_set_line(int fd, uint8_t level) {
+    struct gpiohandle_data data;
+
+    if (fd < 0)
+        return;
+    memset(&data, 0, sizeof(data));
+    data.values[0] = level;
+    ioctl(fd, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &data);
+}
+
+static void gc9a01a_spidev_transfer(const uint8_t *data, uint32_t size) {
+    struct spi_ioc_transfer transfer;
+    uint32_t chunk;
+
+    while (size > 0)
+    {
+        chunk = (size > GC9A01A_SPIDEV_CHUNK) ? GC9A01A_SPIDEV_CHUNK : size;
+        memset(&transfer, 0, sizeof(transfer));
+        transfer.tx_buf = (uintptr_t)data;
+        transfer.len = chunk;
+        transfer.speed_hz = speed_hz;
+        transfer.bits_per_word = 8;
+        if (ioctl(spi_fd, SPI_IOC_MESSAGE(1), &transfer) < 0)
+            return;
+        data += chunk;
+        size -= chunk;
+    }
+}
+
+static void *gc9a01a_spidev_worker(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&job_lock);
+    while (worker_running)
+    {
+        if (!job_pending)
+        {
+            pthread_cond_wait(&job_cond, &job_lock);
+            continue;
+        }
+        pthread_mutex_unlock(&job_lock);
+        gc9a01a_spidev_transfer(job_data, job_size);
+        pthread_mutex_lock(&job_lock);
+        job_pending = 0;
+        pthread_mutex_unlock(&job_lock);
+
+        // the completion may queue the next write right away
+        pthread_mutex_lock(&irq_lock);
+        gc9a01a_transport_tx_complete();
+        pthread_mutex_unlock(&irq_lock);
+        pthread_mutex_lock(&job_lock);
+    }
+    pthread_mutex_unlock(&job_lock);
+    return NULL;
+}
+
+static void gc9a01a_spidev_set_cs(uint8_t level) {
+    gc9a01a_spidev_set_line(cs_fd, level);
+}
+
+static void gc9a01a_spidev_set_dc(uint8_t level) {
+    gc9a01a_spidev_set_line(dc_fd, level);
+}
+
+static void gc9a01a_spidev_set_rst(uint8_t level) {
+    gc9a01a_spidev_set_line(rst_fd, level);
+}
+
+static void gc9a01a_spidev_delay_ms(uint32_t ms) {
+    struct timespec duration = {ms / 1000, (ms % 1000) * 1000000L};
+
+    while (nanosleep(&duration, &duration) < 0 && errno == EINTR)
+        ;
+}
+
+static void gc9a01a_spidev_write_command(uint8_t cmd) {
+    gc9a01a_spidev_transfer(&cmd, 1);
+}
+
+static void gc9a01a_spidev_write_data(const uint8_t *data, uint32_t size) {
+    gc9a01a_spidev_transfer(data, size);
+}
+
+static void gc9a01a_spidev_write_data_async(const uint8_t *data, uint32_t size) {
+    pthread_mutex_lock(&job_lock);
+    job_data = data;
+    job_size = size;
+    job_pending = 1;
+    pthread_cond_signal(&job_cond);
+    pthread_mutex_unlock(&job_lock);
+}
+
+static void gc9a01a_spidev_enter_critical(void) {
+    pthread_mutex_lock(&irq_lock);
+}
+
+static void gc9a01a_spidev_exit_critical(void) {
+    pthread_mutex_unlock(&irq_lock);
+}
+
+int gc9a01a_spidev_open(const gc9a01a_spidev_config_t *config) {
+    uint8_t mode = SPI_MODE_0;
+    uint8_t bits = 8;
+    int chip_fd;
+
+    spi_fd = open(config->spi_device, O_RDWR);
+    if (spi_fd < 0)
+        return -1;
+    if (config->cs_line >= 0)
+    { mode |= SPI_NO_CS; }
+    speed_hz = config->speed_hz;
+    if ((ioctl(spi_fd, SPI_IOC_WR_MODE, &mode) < 0) ||
+        (ioctl(spi_fd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0) ||
+        (ioctl(spi_fd, SPI_IOC_WR_MAX_SPEED_HZ, &speed_hz) < 0))
+    { goto fail; }
+
+    chip_fd = open(config->gpio_chip, O_RDWR);
+    if (chip_fd < 0)
+    { goto fail; }
+    dc_fd = gc9a01a_spidev_request_line(chip_fd, config->dc_line);
+    rst_fd = gc9a01a_spidev_request_line(chip_fd, config->rst_line);
+    cs_fd = gc9a01a_spidev_request_line(chip_fd, config->cs_line);
+    close(chip_fd);
+    if ((dc_fd < 0) || ((config->rst_line >= 0) && (rst_fd < 0)) ||
+        ((config->cs_line >= 0) && (cs_fd < 0)))
+    { goto fail; }
+
+    worker_running = 1;
+    if (pthread_create(&worker, NULL, gc9a01a_spidev_worker, NULL) != 0)
+    {
+        worker_running = 0;
+        goto fail;
+    }
+    return 0;
+
+fail:
+    gc9a01a_spidev_close();
+    return -1;
+}
+
+void gc9a01a_spidev_close(void) {
+    if (worker_running)
+    {
+        pthread_mutex_lock(&job_lock);
+        worker_running = 0;
+        pthread_cond_signal(&job_cond);
+        pthread_mutex_unlock(&job_lock);
+        pthread_join(worker, NULL);
+    }
+    if (cs_fd >= 0)
+        close(cs_fd);
+    if (rst_fd >= 0)
+        close(rst_fd);
+    if (dc_fd >= 0)
+        close(dc_fd);
+    if (spi_fd >= 0)
+        close(spi_fd);
+    cs_fd = rst_fd = dc_fd = spi_fd = -1;
+}
+
+const gc9a01a_transport_t gc9a01a_spidev_transport = {
+    .set_cs = gc9a01a_spidev_set_cs,
+    .set_dc = gc9a01a_spidev_set_dc,
+    .set_rst = gc9a01a_spidev_set_rst,
+    .delay_ms = gc9a01a_spidev_delay_ms,
+    .write_command = gc9a01a_spidev_write_command,
+    .write_data = gc9a01a_spidev_write_data,
+    .write_data_async = gc9a01a_spidev_write_data_async,
+    .enter_critical = gc9a01a_spidev_enter_critical,
+    .exit_critical = gc9a01a_spidev_exit_critical,
+};
+
+#endif /* __linux__ */
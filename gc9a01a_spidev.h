@@ -0,0 +1,76 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_spidev.h
+ * @author  Nabli Hatem
+ * @brief   This module contains the Linux spidev bus backend of the gc9a01a
+ *          driver, D/C, RST and optionally CS are GPIO character device
+ *          lines.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Definition to prevent recursive inclusion -------------------------------*/
+#ifndef GC9A01A_SPIDEV_H
+#define GC9A01A_SPIDEV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes --------------------------------------------------------------- */
+#include "gc9a01a_transport.h"
+
+/**
+ * @brief Linux wiring of the panel.
+ * @param spi_device spidev node, e.g. "/dev/spidev0.0".
+ * @param speed_hz SPI clock frequency.
+ * @param gpio_chip GPIO character device holding the lines, e.g.
+ *        "/dev/gpiochip0".
+ * @param dc_line offset of the D/C line.
+ * @param rst_line offset of the RST line, -1 when not wired.
+ * @param cs_line offset of a GPIO driven CS line, -1 to let spidev drive the
+ *        native CS of the controller.
+ */
+typedef struct
+{
+    const char *spi_device;
+    uint32_t speed_hz;
+    const char *gpio_chip;
+    int32_t dc_line;
+    int32_t rst_line;
+    int32_t cs_line;
+} gc9a01a_spidev_config_t;
+
+/**
+ * @brief Open the SPI device and request the GPIO lines, asynchronous
+ *        writes are run on a worker thread.
+ * @param config the wiring of the panel.
+ * @retval 0 on success, -1 on failure with errno set.
+ */
+int gc9a01a_spidev_open(const gc9a01a_spidev_config_t *config);
+
+/**
+ * @brief Stop the worker thread and release the SPI device and GPIO lines.
+ * @retval None.
+ */
+void gc9a01a_spidev_close(void);
+
+/**
+ * @brief Linux spidev bus, valid after gc9a01a_spidev_open().
+ */
+extern const gc9a01a_transport_t gc9a01a_spidev_transport;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GC9A01A_SPIDEV_H */
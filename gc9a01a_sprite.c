@@ -0,0 +1,180 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_sprite.c
+ * @author  Nabli Hatem
+ * @brief   This module contains the sprite compositor.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#include "gc9a01a_sprite.h"
+#include "gc9a01a_internal.h"
+
+// the panel cannot be read back, compositing needs an offscreen mode
+#if GC9A01A_FRAMEBUFFER || GC9A01A_BAND_LINES
+
+static gc9a01a_sprite_t *sprites[GC9A01A_SPRITES];  ///< Sorted by z, bottom first
+static uint8_t sprite_count = 0;
+static gc9a01a_layer_fn background = NULL;
+static const void *background_data = NULL;
+static gc9a01a_rect_t damage[GC9A01A_SPRITE_DAMAGE];
+static uint8_t damage_count = 0;
+
+/**
+ * Add an area to recomposite, merged with the pending areas it is close to
+ * like the framebuffer dirty rectangles.
+ */
+static void gc9a01a_sprites_damage(int16_t x, int16_t y, int16_t width, int16_t height) {
+    int16_t x1 = x + width - 1, y1 = y + height - 1;
+    gc9a01a_rect_t area;
+
+    if (x < 0)
+    { x = 0; }
+    if (y < 0)
+    { y = 0; }
+    if (x1 >= GC9A01A_TFTWIDTH)
+    { x1 = GC9A01A_TFTWIDTH - 1; }
+    if (y1 >= GC9A01A_TFTHEIGHT)
+    { y1 = GC9A01A_TFTHEIGHT - 1; }
+    if ((x > x1) || (y > y1))
+        return;
+
+    area.x0 = x;
+    area.y0 = y;
+    area.x1 = x1;
+    area.y1 = y1;
+    gc9a01a_rect_merge(damage, &damage_count, GC9A01A_SPRITE_DAMAGE, &area);
+}
+
+/**
+ * Redraw the background and the sprites over an area and send it.
+ */
+static void gc9a01a_sprites_composite(const gc9a01a_rect_t *area) {
+    const gc9a01a_sprite_t *s;
+    uint8_t i;
+
+    gc9a01a_set_clip(area->x0, area->y0, area->x1, area->y1);
+    if (background != NULL)
+    {
+        background(0, 0, background_data);
+    } else
+    {
+        gc9a01a_fill_rectangle(area->x0, area->y0, area->x1 - area->x0 + 1,
+                               area->y1 - area->y0 + 1, 0);
+    }
+    for (i = 0; i < sprite_count; i++)
+    {
+        s = sprites[i];
+        if (s->visible && (s->x <= area->x1) && (s->y <= area->y1) &&
+            (s->x + s->width > area->x0) && (s->y + s->height > area->y0))
+        { s->draw(s->x, s->y, s->data); }
+    }
+    // in the banded build the clip rectangle applies to the whole frame,
+    // so each area is its own frame
+    gc9a01a_flush();
+}
+
+void gc9a01a_sprites_init(gc9a01a_layer_fn draw, const void *data) {
+    background = draw;
+    background_data = data;
+    sprite_count = 0;
+    damage_count = 0;
+    gc9a01a_sprites_damage(0, 0, GC9A01A_TFTWIDTH, GC9A01A_TFTHEIGHT);
+}
+
+/**
+ * Take a sprite out of the list, returns 0 when it was not in it.
+ */
+static uint8_t gc9a01a_sprites_unlink(const gc9a01a_sprite_t *sprite) {
+    uint8_t i;
+
+    for (i = 0; i < sprite_count; i++)
+    {
+        if (sprites[i] == sprite)
+        {
+            for (sprite_count--; i < sprite_count; i++)
+            { sprites[i] = sprites[i + 1]; }
+            return 1;
+        }
+    }
+    return 0;
+}
+
+uint8_t gc9a01a_sprite_add(gc9a01a_sprite_t *sprite) {
+    uint8_t i;
+
+    // a sprite added again keeps its state, the update erases its old box
+    if (!gc9a01a_sprites_unlink(sprite))
+    { sprite->shown = 0; }
+    if (sprite_count == GC9A01A_SPRITES)
+        return 0;
+    // keep the list sorted by z, a new sprite goes above its equals
+    for (i = sprite_count; (i > 0) && (sprites[i - 1]->z > sprite->z); i--)
+    { sprites[i] = sprites[i - 1]; }
+    sprites[i] = sprite;
+    sprite_count++;
+    sprite->changed = 1;
+    return 1;
+}
+
+void gc9a01a_sprite_remove(gc9a01a_sprite_t *sprite) {
+    if (gc9a01a_sprites_unlink(sprite) && sprite->shown)
+    {
+        gc9a01a_sprites_damage(sprite->shown_x, sprite->shown_y, sprite->shown_width,
+                               sprite->shown_height);
+        sprite->shown = 0;
+    }
+}
+
+void gc9a01a_sprite_invalidate(gc9a01a_sprite_t *sprite) {
+    sprite->changed = 1;
+}
+
+void gc9a01a_sprites_invalidate(int16_t x, int16_t y, int16_t width, int16_t height) {
+    gc9a01a_sprites_damage(x, y, width, height);
+}
+
+void gc9a01a_sprites_update(void) {
+    gc9a01a_sprite_t *s;
+    uint8_t i;
+
+    for (i = 0; i < sprite_count; i++)
+    {
+        s = sprites[i];
+        if (!s->changed && ((s->visible != 0) == s->shown) &&
+            (!s->visible || ((s->x == s->shown_x) && (s->y == s->shown_y) &&
+                             (s->width == s->shown_width) && (s->height == s->shown_height))))
+        { continue; }
+
+        // the old and the new box, merged when they overlap or nearly do
+        if (s->shown)
+        { gc9a01a_sprites_damage(s->shown_x, s->shown_y, s->shown_width, s->shown_height); }
+        if (s->visible)
+        { gc9a01a_sprites_damage(s->x, s->y, s->width, s->height); }
+        s->shown = (s->visible != 0);
+        s->shown_x = s->x;
+        s->shown_y = s->y;
+        s->shown_width = s->width;
+        s->shown_height = s->height;
+        s->changed = 0;
+    }
+    if (damage_count == 0)
+        return;
+
+    // draws pending from the application go out before clipping starts
+    gc9a01a_flush();
+    for (i = 0; i < damage_count; i++)
+    { gc9a01a_sprites_composite(&damage[i]); }
+    damage_count = 0;
+    gc9a01a_reset_clip();
+}
+
+#endif
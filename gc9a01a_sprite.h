@@ -0,0 +1,122 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_sprite.h
+ * @author  Nabli Hatem
+ * @brief   This module composites a background and movable sprites, sending
+ *          only the areas that changed. It needs GC9A01A_FRAMEBUFFER or
+ *          GC9A01A_BAND_LINES.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Definition to prevent recursive inclusion -------------------------------*/
+#ifndef GC9A01A_SPRITE_H
+#define GC9A01A_SPRITE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes --------------------------------------------------------------- */
+#include <stdint.h>
+
+#ifndef GC9A01A_SPRITES
+#define GC9A01A_SPRITES 16  ///< Sprites the compositor can hold
+#endif
+
+#ifndef GC9A01A_SPRITE_DAMAGE
+#define GC9A01A_SPRITE_DAMAGE 8  ///< Areas recomposited per update, close ones are merged
+#endif
+
+/**
+ * @brief Draws a layer with the gc9a01a primitives, the compositor clips it
+ *        to the area being recomposited.
+ * @param x x-cordinate of the layer.
+ * @param y y-cordinate of the layer.
+ * @param data the data of the layer.
+ */
+typedef void (*gc9a01a_layer_fn)(int16_t x, int16_t y, const void *data);
+
+/**
+ * @brief A sprite. The application owns it, sets the public fields and may
+ *        change x, y and visible at any time, the next
+ *        gc9a01a_sprites_update() shows the change.
+ */
+typedef struct
+{
+    int16_t x, y;           ///< Top left corner of the sprite box
+    int16_t width, height;  ///< Size of the box draw stays in
+    gc9a01a_layer_fn draw;  ///< Draws the sprite at (x, y)
+    const void *data;       ///< Passed to draw
+    int8_t z;               ///< Sprites with a higher z are drawn on top, read when added
+    uint8_t visible;        ///< 0 hides the sprite
+    /* Compositor state */
+    int16_t shown_x, shown_y;           ///< Box the panel shows the sprite in
+    int16_t shown_width, shown_height;  ///< Box the panel shows the sprite in
+    uint8_t shown;                      ///< The sprite is on the panel
+    uint8_t changed;                    ///< Set by gc9a01a_sprite_invalidate()
+} gc9a01a_sprite_t;
+
+/**
+ * @brief Remove every sprite and set the background, the next update
+ *        redraws the whole screen.
+ * @param background draws the background at (0, 0), NULL for black.
+ * @param data passed to background.
+ * @retval None.
+ */
+void gc9a01a_sprites_init(gc9a01a_layer_fn background, const void *data);
+
+/**
+ * @brief Add a sprite above the sprites of lower or equal z. Adding it again
+ *        takes a new z into account.
+ * @param sprite the sprite, it must stay valid until removed.
+ * @retval 1 on success, 0 when GC9A01A_SPRITES sprites are already added.
+ */
+uint8_t gc9a01a_sprite_add(gc9a01a_sprite_t *sprite);
+
+/**
+ * @brief Remove a sprite, the next update erases it.
+ * @param sprite the sprite.
+ * @retval None.
+ */
+void gc9a01a_sprite_remove(gc9a01a_sprite_t *sprite);
+
+/**
+ * @brief Redraw a sprite whose content changed without moving.
+ * @param sprite the sprite.
+ * @retval None.
+ */
+void gc9a01a_sprite_invalidate(gc9a01a_sprite_t *sprite);
+
+/**
+ * @brief Recomposite an area, for example after the background changed.
+ * @param x x-cordinate of the area.
+ * @param y y-cordinate of the area.
+ * @param width width of the area.
+ * @param height height of the area.
+ * @retval None.
+ */
+void gc9a01a_sprites_invalidate(int16_t x, int16_t y, int16_t width, int16_t height);
+
+/**
+ * @brief Recomposite and send the areas that changed since the previous
+ *        update: for each sprite that moved, changed or was hidden, its
+ *        old and new boxes.
+ * @retval None.
+ */
+void gc9a01a_sprites_update(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GC9A01A_SPRITE_H */
@@ -0,0 +1,97 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_stm32.c
+ * @author  Nabli Hatem
+ * @brief   This module contains the implementation of the STM32 HAL bus
+ *          backend of the gc9a01a driver.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+#ifdef USE_HAL_DRIVER
+
+#include "gc9a01a_stm32.h"
+#include "gc9a01a.h"
+
+extern SPI_HandleTypeDef GC9A01A_SPI;
+
+#if USE_DMA
+static uint32_t primask;
+#endif
+
+static void gc9a01a_stm32_set_cs(uint8_t level) {
+    HAL_GPIO_WritePin(GC9A01A_CS_PORT, GC9A01A_CS_PIN, level ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+static void gc9a01a_stm32_set_dc(uint8_t level) {
+    HAL_GPIO_WritePin(GC9A01A_DC_PORT, GC9A01A_DC_PIN, level ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+static void gc9a01a_stm32_set_rst(uint8_t level) {
+    HAL_GPIO_WritePin(GC9A01A_RST_PORT, GC9A01A_RST_PIN, level ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+static void gc9a01a_stm32_delay_ms(uint32_t ms) {
+    HAL_Delay(ms);
+}
+
+static void gc9a01a_stm32_write_command(uint8_t cmd) {
+    HAL_SPI_Transmit(&GC9A01A_SPI, &cmd, 1, GC9A01A_SPI_TIMEOUT);
+}
+
+static void gc9a01a_stm32_write_data(const uint8_t *data, uint32_t size) {
+    // HAL transfers are limited to 65535 bytes
+    while (size > 0)
+    {
+        uint16_t chunk = (size > 0xFFFF) ? 0xFFFF : size;
+        HAL_SPI_Transmit(&GC9A01A_SPI, (uint8_t *)data, chunk, GC9A01A_SPI_TIMEOUT);
+        data += chunk;
+        size -= chunk;
+    }
+}
+
+#if USE_DMA
+static void gc9a01a_stm32_write_data_async(const uint8_t *data, uint32_t size) {
+    HAL_SPI_Transmit_DMA(&GC9A01A_SPI, (uint8_t *)data, size);
+}
+
+static void gc9a01a_stm32_enter_critical(void) {
+    uint32_t mask = __get_PRIMASK();
+    __disable_irq();
+    primask = mask;
+}
+
+static void gc9a01a_stm32_exit_critical(void) {
+    __set_PRIMASK(primask);
+}
+
+// === DMA CALLBACK ===
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi) {
+    if (hspi == &GC9A01A_SPI)
+    { gc9a01a_transport_tx_complete(); }
+}
+#endif
+
+const gc9a01a_transport_t gc9a01a_stm32_transport = {
+    .set_cs = gc9a01a_stm32_set_cs,
+    .set_dc = gc9a01a_stm32_set_dc,
+    .set_rst = gc9a01a_stm32_set_rst,
+    .delay_ms = gc9a01a_stm32_delay_ms,
+    .write_command = gc9a01a_stm32_write_command,
+    .write_data = gc9a01a_stm32_write_data,
+#if USE_DMA
+    .write_data_async = gc9a01a_stm32_write_data_async,
+    .enter_critical = gc9a01a_stm32_enter_critical,
+    .exit_critical = gc9a01a_stm32_exit_critical,
+#endif
+};
+
+#endif /* USE_HAL_DRIVER */
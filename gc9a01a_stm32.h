@@ -0,0 +1,47 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_stm32.h
+ * @author  Nabli Hatem
+ * @brief   This module contains the STM32 HAL bus backend of the gc9a01a
+ *          driver.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Definition to prevent recursive inclusion -------------------------------*/
+#ifndef GC9A01A_STM32_H
+#define GC9A01A_STM32_H
+
+/* Includes --------------------------------------------------------------- */
+#include "gc9a01a_transport.h"
+
+#include "main.h"
+
+#define GC9A01A_SPI hspi2
+#define GC9A01A_SPI_TIMEOUT 100
+
+#define GC9A01A_CS_PORT GPIOB
+#define GC9A01A_CS_PIN LCD_CS_Pin
+
+#define GC9A01A_DC_PORT GPIOB
+#define GC9A01A_DC_PIN LCD_DC_Pin
+
+#define GC9A01A_RST_PORT GPIOB
+#define GC9A01A_RST_PIN LCD_RST_Pin
+
+/**
+ * @brief STM32 HAL bus, uses HAL_SPI_Transmit_DMA for pixel data when
+ *        USE_DMA is set and HAL_SPI_TxCpltCallback is routed to the driver.
+ */
+extern const gc9a01a_transport_t gc9a01a_stm32_transport;
+
+#endif /* GC9A01A_STM32_H */
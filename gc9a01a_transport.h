@@ -0,0 +1,86 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_transport.h
+ * @author  Nabli Hatem
+ * @brief   This module defines the bus interface used by the gc9a01a driver
+ *          to reach the panel, so that the same driver can run on top of the
+ *          STM32 HAL, Linux spidev or an in-memory recorder.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Definition to prevent recursive inclusion -------------------------------*/
+#ifndef GC9A01A_TRANSPORT_H
+#define GC9A01A_TRANSPORT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes --------------------------------------------------------------- */
+#include <stdint.h>
+
+/**
+ * @brief Bus operations needed by the gc9a01a driver.
+ * @param set_cs drive the chip select line, 0 selects the panel.
+ * @param set_dc drive the data/command line, 0 for command and 1 for data.
+ *        May be NULL when the bus carries D/C in-band (3-wire 9-bit SPI).
+ * @param set_rst drive the reset line. May be NULL when the panel has no
+ *        reset line wired, a software reset is sent instead.
+ * @param delay_ms wait for the given number of milliseconds.
+ * @param write_command send one command byte, D/C is already low.
+ * @param write_data send parameter or pixel bytes and return once they are
+ *        out, D/C is already high.
+ * @param write_data_async start sending pixel bytes and return immediately,
+ *        gc9a01a_transport_tx_complete() must be called once they are out.
+ *        The buffer stays untouched until then. May be NULL, write_data is
+ *        used instead.
+ * @param write_color send count copies of a RGB565 color, D/C is already
+ *        high. May be NULL, the driver then replicates the color itself.
+ * @param enter_critical keep gc9a01a_transport_tx_complete() from running,
+ *        may be NULL when write_data_async is NULL.
+ * @param exit_critical undo enter_critical.
+ */
+typedef struct
+{
+    void (*set_cs)(uint8_t level);
+    void (*set_dc)(uint8_t level);
+    void (*set_rst)(uint8_t level);
+    void (*delay_ms)(uint32_t ms);
+    void (*write_command)(uint8_t cmd);
+    void (*write_data)(const uint8_t *data, uint32_t size);
+    void (*write_data_async)(const uint8_t *data, uint32_t size);
+    void (*write_color)(uint16_t color, uint32_t count);
+    void (*enter_critical)(void);
+    void (*exit_critical)(void);
+} gc9a01a_transport_t;
+
+/**
+ * @brief Select the bus used by the driver, must be called before
+ *        gc9a01a_init() unless GC9A01A_DEFAULT_TRANSPORT is defined.
+ * @param transport the bus operations.
+ * @retval None.
+ */
+void gc9a01a_set_transport(const gc9a01a_transport_t *transport);
+
+/**
+ * @brief Report the end of a write_data_async transfer, from interrupt or
+ *        worker thread context.
+ * @retval None.
+ */
+void gc9a01a_transport_tx_complete(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GC9A01A_TRANSPORT_H */
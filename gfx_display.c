@@ -107,7 +107,7 @@ void gfx_display_draw_triangle(int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_
 }
 
 void gfx_display_fill_triangle(int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_1, int16_t x_2,
-                               int16_t y_2, int16_t color) {
+                               int16_t y_2, uint16_t color) {
     if (lcd_driver && lcd_driver->fill_triangle)
     { lcd_driver->fill_triangle(x_0, y_0, x_1, y_1, x_2, y_2, color); }
 }
@@ -53,7 +53,7 @@ typedef struct
     void (*draw_triangle)(int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_1, int16_t x_2,
                           int16_t y_2, uint16_t color);
     void (*fill_triangle)(int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_1, int16_t x_2,
-                          int16_t y_2, int16_t color);
+                          int16_t y_2, uint16_t color);
     void (*draw_round_rectangle)(int16_t x_0, int16_t y_0, int16_t width, int16_t height,
                                  int16_t radius, uint16_t color);
     void (*fill_round_rectangle)(int16_t x_0, int16_t y_0, int16_t width, int16_t height,
@@ -224,7 +224,9 @@ void gfx_display_fill_ellipse(int16_t x, int16_t y, int16_t width, int16_t heigh
 void gfx_display_draw_triangle(int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_1, int16_t x_2,
                                int16_t y_2, uint16_t color);
 /**
- * @brief Fill a triangle with a specific color.
+ * @brief Fill a triangle with a specific color. Pixels on the top and left
+ *        edges are filled and those on the bottom and right edges are not,
+ *        so triangles sharing an edge cover each pixel once.
  * @param x_0 x-cordinate of the first pixel.
  * @param y_0 y-cordinate of the first pixel.
  * @param x_1 x-cordinate of the second pixel.
@@ -235,7 +237,7 @@ void gfx_display_draw_triangle(int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_
  * @retval None.
  */
 void gfx_display_fill_triangle(int16_t x_0, int16_t y_0, int16_t x_1, int16_t y_1, int16_t x_2,
-                               int16_t y_2, int16_t color);
+                               int16_t y_2, uint16_t color);
 /**
  * @brief Draw a round rectangle at a specific position.
  * @param x_0 x-cordinate of the rectangle position.
@@ -32,15 +32,22 @@ extern "C" {
 
 /**
  * @brief This is the data stored for font.
- * @param width This is the width of the font.
+ * @param width This is the width of the font, at most 16.
  * @param hight This is the height of the font.
- * @param data  This is the data table.
+ * @param data  This is the data table, one uint16_t per glyph row with the
+ *              left pixel in the most significant bit. NULL when bits is
+ *              used.
+ * @param bits  This is the packed data table: the glyph rows following each
+ *              other width bits at a time, most significant bit first. Used
+ *              instead of data when not NULL, tools/gc9a01a_font.py
+ *              generates it.
  */
 typedef struct
 {
     uint8_t width;
     uint8_t height;
     const uint16_t *data;
+    const uint8_t *bits;
 } glcd_font_t;
 /**
  * @brief This structure define the size of the font.
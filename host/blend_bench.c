@@ -0,0 +1,116 @@
+/**
+ *****************************************************************************
+ * @file    blend_bench.c
+ * @author  Nabli Hatem
+ * @brief   Time every blend kernel compiled for the host and print the
+ *          pixels per second of each. The kernels are static, so this
+ *          program includes gc9a01a_blend.c instead of linking it.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#define _POSIX_C_SOURCE 200809L  ///< clock_gettime() with -std=c11
+
+#include "gc9a01a_blend.c"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SPAN GC9A01A_TFTWIDTH  ///< Pixels per call, one screen row
+#define ROWS 64                ///< Rows of different data cycled through
+#define PASSES 2000            ///< Times every row is blended
+
+typedef void (*blend_kernel_t)(uint16_t *dst, const uint16_t *fg, uint16_t color,
+                               const uint8_t *alpha, uint16_t count);
+
+static const struct
+{
+    const char *name;
+    blend_kernel_t blend;
+} kernels[] = {
+    {"scalar", gc9a01a_blend_scalar},
+#if GC9A01A_BLEND_DSP
+    {"dsp", gc9a01a_blend_dsp},
+#endif
+#if GC9A01A_BLEND_NEON
+    {"neon", gc9a01a_blend_neon},
+#endif
+#if GC9A01A_BLEND_SSE2
+    {"sse2", gc9a01a_blend_sse2},
+#endif
+};
+
+static uint16_t source[ROWS][SPAN];
+static uint16_t background[ROWS][SPAN];
+static uint8_t alpha[ROWS][SPAN];
+static uint16_t dst[ROWS][SPAN];
+static uint16_t reference[ROWS][SPAN];
+
+static double now(void) {
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// blend every row once, from the same background, with an image or a color
+static void blend_rows(blend_kernel_t blend, uint8_t image) {
+    uint16_t row;
+
+    memcpy(dst, background, sizeof(dst));
+    for (row = 0; row < ROWS; row++)
+    { blend(dst[row], image ? source[row] : NULL, 0xFD20, alpha[row], SPAN); }
+}
+
+int main(void) {
+    double start, seconds;
+    uint32_t pass;
+    uint16_t row, i;
+    uint8_t k, image;
+
+    srand(1);
+    for (row = 0; row < ROWS; row++)
+    {
+        for (i = 0; i < SPAN; i++)
+        {
+            source[row][i] = rand();
+            background[row][i] = rand();
+            // anti-aliased art: mostly clear or opaque, the rest partial
+            alpha[row][i] = (rand() % 4 == 0) ? rand() : ((rand() & 1) ? 255 : 0);
+        }
+    }
+
+    for (image = 0; image < 2; image++)
+    {
+        blend_rows(gc9a01a_blend_scalar, image);
+        memcpy(reference, dst, sizeof(dst));
+        for (k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+        {
+            blend_rows(kernels[k].blend, image);
+            if (memcmp(dst, reference, sizeof(dst)) != 0)
+            {
+                printf("%s differs from the scalar kernel\n", kernels[k].name);
+                return 1;
+            }
+            start = now();
+            for (pass = 0; pass < PASSES; pass++)
+            {
+                for (row = 0; row < ROWS; row++)
+                { kernels[k].blend(dst[row], image ? source[row] : NULL, 0xFD20, alpha[row], SPAN); }
+            }
+            seconds = now() - start;
+            printf("%-6s %-5s %8.1f Mpixels/s\n", kernels[k].name, image ? "image" : "color",
+                   (double)PASSES * ROWS * SPAN / seconds / 1e6);
+        }
+    }
+    return 0;
+}
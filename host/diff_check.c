@@ -0,0 +1,135 @@
+/**
+ *****************************************************************************
+ * @file    diff_check.c
+ * @author  Nabli Hatem
+ * @brief   Check that GC9A01A_FRAME_DIFF never leaves the panel behind what
+ *          was drawn, when several rectangles of one flush or a clipped
+ *          band frame cover parts of the same row segment.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "gc9a01a.h"
+#include "gc9a01a_host.h"
+#include "gc9a01a_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#if !GC9A01A_FRAME_DIFF
+#error "diff_check needs GC9A01A_FRAME_DIFF and an offscreen mode"
+#endif
+
+#define WHITE 0xFFFF
+#define RED 0xF800
+#define BLUE 0x001F
+
+static uint32_t failures = 0;
+
+static void check(const char *name, uint32_t wrong) {
+    printf("%-40s %s (%u pixels wrong)\n", name, wrong ? "FAIL" : "ok", (unsigned)wrong);
+    if (wrong)
+    { failures++; }
+}
+
+#if GC9A01A_FRAMEBUFFER
+// pixels of the panel that differ from the framebuffer
+static uint32_t panel_errors(void) {
+    const uint16_t *panel = gc9a01a_host_panel();
+    const uint8_t *frame = (const uint8_t *)gc9a01a_get_framebuffer();
+    uint32_t i, wrong = 0;
+
+    for (i = 0; i < GC9A01A_TFTWIDTH * GC9A01A_TFTHEIGHT; i++)
+    {
+        if (panel[i] != ((frame[2 * i] << 8) | frame[2 * i + 1]))
+        { wrong++; }
+    }
+    return wrong;
+}
+
+static void check_shared_segment(void) {
+    gc9a01a_fill_screen(WHITE);
+    gc9a01a_flush();
+    // two rectangles too far apart to merge, both in rows 50..99 of segment 0
+    gc9a01a_fill_rectangle(5, 0, 10, 100, RED);
+    gc9a01a_fill_rectangle(15, 50, 8, 100, BLUE);
+    gc9a01a_flush();
+    gc9a01a_wait_idle();
+    check("two rectangles sharing a segment", panel_errors());
+}
+
+static void check_random_rectangles(void) {
+    uint32_t wrong = 0;
+    uint16_t frame, i;
+
+    srand(1);
+    for (frame = 0; frame < 200; frame++)
+    {
+        for (i = 0; i < 1 + rand() % 12; i++)
+        {
+            gc9a01a_fill_rectangle(rand() % GC9A01A_TFTWIDTH, rand() % GC9A01A_TFTHEIGHT,
+                                   1 + rand() % 40, 1 + rand() % 40, rand() % 4 ? RED : BLUE);
+        }
+        gc9a01a_flush();
+        gc9a01a_wait_idle();
+        wrong += panel_errors();
+    }
+    check("random rectangles over 200 flushes", wrong);
+}
+#endif
+
+#if GC9A01A_BAND_LINES
+// pixels of the panel other than color left of column split and black right of it
+static uint32_t panel_errors(uint16_t split, uint16_t color) {
+    const uint16_t *panel = gc9a01a_host_panel();
+    uint32_t i, wrong = 0;
+
+    for (i = 0; i < GC9A01A_TFTWIDTH * GC9A01A_TFTHEIGHT; i++)
+    {
+        if (panel[i] != ((i % GC9A01A_TFTWIDTH < split) ? color : 0x0000))
+        { wrong++; }
+    }
+    return wrong;
+}
+
+static void check_clipped_frame(void) {
+    gc9a01a_set_background(0x0000);
+    gc9a01a_fill_screen(WHITE);
+    gc9a01a_flush();
+    // only columns 0..11 of segment 0 go out, the panel keeps white past them
+    gc9a01a_set_clip(0, 0, 11, GC9A01A_TFTHEIGHT - 1);
+    gc9a01a_fill_rectangle(0, 0, 12, GC9A01A_TFTHEIGHT, RED);
+    gc9a01a_flush();
+    gc9a01a_reset_clip();
+    // the same band content over the whole screen must repaint columns 12..
+    gc9a01a_fill_rectangle(0, 0, 12, GC9A01A_TFTHEIGHT, RED);
+    gc9a01a_flush();
+    gc9a01a_wait_idle();
+    check("clipped frame then full frame", panel_errors(12, RED));
+}
+#endif
+
+int main(void) {
+#if USE_DMA
+    gc9a01a_set_transport(&gc9a01a_host_threaded_transport);
+#else
+    gc9a01a_set_transport(&gc9a01a_host_transport);
+#endif
+    gc9a01a_init();
+#if GC9A01A_FRAMEBUFFER
+    check_shared_segment();
+    check_random_rectangles();
+#endif
+#if GC9A01A_BAND_LINES
+    check_clipped_frame();
+#endif
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,76 @@
+/**
+ *****************************************************************************
+ * @file    dma_check.c
+ * @author  Nabli Hatem
+ * @brief   Draw a fixed scene and print a summary of the bytes the panel
+ *          received. Built polled (host bus) and with USE_DMA set (threaded
+ *          bus), the two summaries must be the same.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "gc9a01a.h"
+#include "gc9a01a_host.h"
+#include "glcdfont.h"
+#include <stdio.h>
+
+static uint16_t image[48 * 32];
+
+static void draw_scene(uint8_t step) {
+    uint16_t i;
+
+    gc9a01a_fill_screen(0x0000);
+    gc9a01a_fill_rectangle(10 + step, 20, 200, 60, 0xF800);
+    gc9a01a_fill_circle(120, 120, 70 - step, 0x07E0);
+    gc9a01a_draw_circle(120, 120, 90, 0xFFFF);
+    gc9a01a_fill_triangle(30, 200, 210, 180 - step, 120, 100, 0x001F);
+    for (i = 0; i < 12; i++)
+    { gc9a01a_draw_line(0, i * 20, 239, 239 - i * 20 - step, 0xFFE0); }
+    gc9a01a_draw_image(96 + step, 150, 48, 32, image);
+    gc9a01a_write_string(40, 110, "polled = dma", font_11_x_18, 0xFFFF, 0x0000);
+    gc9a01a_fill_round_rectangle(60, 30 + step, 120, 40, 10, 0x7BEF);
+    gc9a01a_flush();
+}
+
+int main(void) {
+    const uint16_t *panel;
+    gc9a01a_host_counters_t counters;
+    uint32_t checksum = 2166136261u, i;
+    uint8_t step;
+
+    for (i = 0; i < 48 * 32; i++)
+    { image[i] = (uint16_t)(i * 2654435761u >> 16); }
+
+#if USE_DMA
+    gc9a01a_set_transport(&gc9a01a_host_threaded_transport);
+#else
+    gc9a01a_set_transport(&gc9a01a_host_transport);
+#endif
+    gc9a01a_init();
+    for (step = 0; step < 8; step++)
+    { draw_scene(step); }
+    gc9a01a_wait_idle();
+
+    panel = gc9a01a_host_panel();
+    for (i = 0; i < GC9A01A_TFTWIDTH * GC9A01A_TFTHEIGHT; i++)
+    { checksum = (checksum ^ panel[i]) * 16777619u; }
+    gc9a01a_host_get_counters(&counters);
+    printf("stream %08x commands %u data bytes %u panel %08x\n", (unsigned)counters.stream_hash,
+           (unsigned)counters.commands, (unsigned)counters.data_bytes, (unsigned)checksum);
+    if (counters.violations != 0)
+    {
+        fprintf(stderr, "%u bus operations during a DMA transfer\n",
+                (unsigned)counters.violations);
+        return 1;
+    }
+    return 0;
+}
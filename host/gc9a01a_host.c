@@ -0,0 +1,274 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_host.c
+ * @author  Nabli Hatem
+ * @brief   This module contains the implementation of the emulated panel
+ *          and of its polled and threaded host buses.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#define _POSIX_C_SOURCE 200809L  ///< nanosleep() with -std=c11
+
+#include "gc9a01a_host.h"
+#include "gc9a01a.h"
+#include <pthread.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+#define GC9A01A_HOST_NS_PER_BYTE 2  ///< Time the worker takes per byte of a transfer
+
+static uint16_t panel[GC9A01A_TFTWIDTH * GC9A01A_TFTHEIGHT];
+static gc9a01a_host_counters_t counters = {.stream_hash = 2166136261u};
+
+/**
+ * State of the emulated controller: D/C level, command being received and
+ * where the next pixel of a memory write lands.
+ */
+static struct
+{
+    uint8_t dc;
+    uint8_t cmd;
+    uint8_t args[4];
+    uint8_t arg_count;
+    uint8_t writing;
+    uint8_t half;
+    uint8_t high;
+    uint16_t x0, x1, y0, y1;
+    uint16_t x, y;
+} ctrl;
+
+/**
+ * Transfer handed to the worker thread. Every field is guarded by irq_lock,
+ * which is also the critical section of the threaded bus.
+ */
+static pthread_mutex_t irq_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t irq_wake = PTHREAD_COND_INITIALIZER;
+static pthread_once_t worker_once = PTHREAD_ONCE_INIT;
+static const uint8_t *job_data;
+static uint32_t job_size;
+static uint8_t job_pending = 0;
+static volatile uint8_t job_busy = 0;
+
+static inline void gc9a01a_host_hash(uint16_t value) {
+    counters.stream_hash = (counters.stream_hash ^ value) * 16777619u;
+}
+
+static void gc9a01a_host_pixel(uint16_t color) {
+    if ((ctrl.x < GC9A01A_TFTWIDTH) && (ctrl.y < GC9A01A_TFTHEIGHT))
+    { panel[ctrl.y * GC9A01A_TFTWIDTH + ctrl.x] = color; }
+    // the cursor wraps inside the window like the panel does
+    if (ctrl.x++ >= ctrl.x1)
+    {
+        ctrl.x = ctrl.x0;
+        if (ctrl.y++ >= ctrl.y1)
+        { ctrl.y = ctrl.y0; }
+    }
+}
+
+static void gc9a01a_host_command(uint8_t cmd) {
+    counters.commands++;
+    gc9a01a_host_hash(0x100 | cmd);
+    ctrl.cmd = cmd;
+    ctrl.arg_count = 0;
+    ctrl.half = 0;
+    ctrl.writing = (cmd == GC9A01A_RAM_MEM_WR) || (cmd == GC9A01A_WMEMC);
+    if (cmd == GC9A01A_RAM_MEM_WR)
+    {
+        ctrl.x = ctrl.x0;
+        ctrl.y = ctrl.y0;
+    }
+}
+
+static void gc9a01a_host_data(const uint8_t *data, uint32_t size) {
+    uint32_t i;
+
+    counters.data_bytes += size;
+    for (i = 0; i < size; i++)
+    {
+        gc9a01a_host_hash(data[i]);
+        if (ctrl.writing)
+        {
+            if (ctrl.half)
+            { gc9a01a_host_pixel((ctrl.high << 8) | data[i]); }
+            ctrl.high = data[i];
+            ctrl.half ^= 1;
+        } else if (((ctrl.cmd == GC9A01A_CASET) || (ctrl.cmd == GC9A01A_ROW_SET)) &&
+                   (ctrl.arg_count < 4))
+        {
+            ctrl.args[ctrl.arg_count++] = data[i];
+            if (ctrl.arg_count < 4)
+            { continue; }
+            if (ctrl.cmd == GC9A01A_CASET)
+            {
+                ctrl.x0 = (ctrl.args[0] << 8) | ctrl.args[1];
+                ctrl.x1 = (ctrl.args[2] << 8) | ctrl.args[3];
+            } else
+            {
+                ctrl.y0 = (ctrl.args[0] << 8) | ctrl.args[1];
+                ctrl.y1 = (ctrl.args[2] << 8) | ctrl.args[3];
+            }
+        }
+    }
+}
+
+/**
+ * Synchronous operations must wait for the running transfer, like a SPI
+ * peripheral shared with a DMA channel.
+ */
+static inline void gc9a01a_host_check_idle(void) {
+    if (job_busy)
+    { counters.violations++; }
+}
+
+static void gc9a01a_host_set_cs(uint8_t level) {
+    (void)level;
+    gc9a01a_host_check_idle();
+}
+
+static void gc9a01a_host_set_dc(uint8_t level) {
+    gc9a01a_host_check_idle();
+    ctrl.dc = level;
+}
+
+static void gc9a01a_host_set_rst(uint8_t level) {
+    (void)level;
+}
+
+static void gc9a01a_host_delay_ms(uint32_t ms) {
+    (void)ms;
+}
+
+static void gc9a01a_host_write_command(uint8_t cmd) {
+    gc9a01a_host_check_idle();
+    if (ctrl.dc != 0)
+    { counters.violations++; }
+    gc9a01a_host_command(cmd);
+}
+
+static void gc9a01a_host_write_data(const uint8_t *data, uint32_t size) {
+    gc9a01a_host_check_idle();
+    if (ctrl.dc != 1)
+    { counters.violations++; }
+    gc9a01a_host_data(data, size);
+}
+
+static void gc9a01a_host_write_data_async(const uint8_t *data, uint32_t size) {
+    counters.transfers++;
+    gc9a01a_host_write_data(data, size);
+    gc9a01a_transport_tx_complete();
+}
+
+static void gc9a01a_host_write_color(uint16_t color, uint32_t count) {
+    uint8_t pixel[2] = {color >> 8, color & 0xFF};
+
+    while (count-- > 0)
+    { gc9a01a_host_write_data(pixel, 2); }
+}
+
+/**
+ * Worker thread playing the DMA channel and its completion interrupt.
+ */
+static void *gc9a01a_host_worker(void *arg) {
+    const uint8_t *data;
+    struct timespec delay = {0, 0};
+    uint32_t size;
+
+    (void)arg;
+    pthread_mutex_lock(&irq_lock);
+    for (;;)
+    {
+        while (!job_pending)
+        { pthread_cond_wait(&irq_wake, &irq_lock); }
+        job_pending = 0;
+        data = job_data;
+        size = job_size;
+        pthread_mutex_unlock(&irq_lock);
+
+        // the driver keeps running while the bytes go out
+        delay.tv_nsec = (long)size * GC9A01A_HOST_NS_PER_BYTE;
+        nanosleep(&delay, NULL);
+        if (ctrl.dc != 1)
+        { counters.violations++; }
+        gc9a01a_host_data(data, size);
+
+        pthread_mutex_lock(&irq_lock);
+        job_busy = 0;
+        gc9a01a_transport_tx_complete();
+    }
+    return NULL;
+}
+
+static void gc9a01a_host_start_worker(void) {
+    pthread_t thread;
+
+    pthread_create(&thread, NULL, gc9a01a_host_worker, NULL);
+    pthread_detach(thread);
+}
+
+// called with irq_lock held, from the driver or from the completion
+static void gc9a01a_host_threaded_write_data_async(const uint8_t *data, uint32_t size) {
+    pthread_once(&worker_once, gc9a01a_host_start_worker);
+    gc9a01a_host_check_idle();
+    counters.transfers++;
+    job_data = data;
+    job_size = size;
+    job_pending = 1;
+    job_busy = 1;
+    pthread_cond_signal(&irq_wake);
+}
+
+static void gc9a01a_host_enter_critical(void) {
+    pthread_mutex_lock(&irq_lock);
+}
+
+static void gc9a01a_host_exit_critical(void) {
+    pthread_mutex_unlock(&irq_lock);
+}
+
+const uint16_t *gc9a01a_host_panel(void) {
+    return panel;
+}
+
+void gc9a01a_host_get_counters(gc9a01a_host_counters_t *out) {
+    *out = counters;
+}
+
+void gc9a01a_host_reset(void) {
+    memset(&counters, 0, sizeof(counters));
+    counters.stream_hash = 2166136261u;
+}
+
+const gc9a01a_transport_t gc9a01a_host_transport = {
+    .set_cs = gc9a01a_host_set_cs,
+    .set_dc = gc9a01a_host_set_dc,
+    .set_rst = gc9a01a_host_set_rst,
+    .delay_ms = gc9a01a_host_delay_ms,
+    .write_command = gc9a01a_host_write_command,
+    .write_data = gc9a01a_host_write_data,
+    .write_data_async = gc9a01a_host_write_data_async,
+    .write_color = gc9a01a_host_write_color,
+};
+
+const gc9a01a_transport_t gc9a01a_host_threaded_transport = {
+    .set_cs = gc9a01a_host_set_cs,
+    .set_dc = gc9a01a_host_set_dc,
+    .set_rst = gc9a01a_host_set_rst,
+    .delay_ms = gc9a01a_host_delay_ms,
+    .write_command = gc9a01a_host_write_command,
+    .write_data = gc9a01a_host_write_data,
+    .write_data_async = gc9a01a_host_threaded_write_data_async,
+    .write_color = gc9a01a_host_write_color,
+    .enter_critical = gc9a01a_host_enter_critical,
+    .exit_critical = gc9a01a_host_exit_critical,
+};
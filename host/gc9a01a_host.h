@@ -0,0 +1,90 @@
+/**
+ *****************************************************************************
+ * @file    gc9a01a_host.h
+ * @author  Nabli Hatem
+ * @brief   This module emulates a GC9A01A panel on a POSIX host, behind a
+ *          polled bus and a bus completing its DMA on a worker thread, for
+ *          the host checks and benchmarks.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+/* Definition to prevent recursive inclusion -------------------------------*/
+#ifndef GC9A01A_HOST_H
+#define GC9A01A_HOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes --------------------------------------------------------------- */
+#include "gc9a01a_transport.h"
+
+/**
+ * @brief Traffic seen by the emulated panel.
+ * @param commands number of command bytes.
+ * @param data_bytes number of parameter and pixel bytes.
+ * @param transfers number of write_data_async transfers.
+ * @param violations number of bus operations made while a write_data_async
+ *        transfer was still running.
+ * @param stream_hash FNV-1a hash of every byte, commands told apart from
+ *        data, equal for two runs that sent the same stream however it was
+ *        split into writes.
+ */
+typedef struct
+{
+    uint32_t commands;
+    uint32_t data_bytes;
+    uint32_t transfers;
+    uint32_t violations;
+    uint32_t stream_hash;
+} gc9a01a_host_counters_t;
+
+/**
+ * @brief Pixels of the emulated panel, GC9A01A_TFTWIDTH per row, decoded
+ *        from the CASET, RASET, RAMWR and Write Memory Continue commands.
+ * @retval the pixels in RGB565 format.
+ */
+const uint16_t *gc9a01a_host_panel(void);
+
+/**
+ * @brief Read the traffic counters.
+ * @param counters where to copy the counters.
+ * @retval None.
+ */
+void gc9a01a_host_get_counters(gc9a01a_host_counters_t *counters);
+
+/**
+ * @brief Clear the traffic counters, the panel keeps its pixels.
+ * @retval None.
+ */
+void gc9a01a_host_reset(void);
+
+/**
+ * @brief Emulated panel behind a polled bus, asynchronous writes complete
+ *        before they return.
+ */
+extern const gc9a01a_transport_t gc9a01a_host_transport;
+
+/**
+ * @brief Emulated panel behind a bus whose asynchronous writes are sent by a
+ *        worker thread, which then calls gc9a01a_transport_tx_complete().
+ *        The critical section is the mutex held by the worker around that
+ *        call, like an interrupt masked on a MCU.
+ */
+extern const gc9a01a_transport_t gc9a01a_host_threaded_transport;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GC9A01A_HOST_H */
@@ -0,0 +1,65 @@
+#!/bin/sh
+# Build and run the host checks, then the benchmarks, from anywhere:
+#   sh host/run.sh
+# CC, CFLAGS and OUT (the build directory) can be overridden.
+set -e
+cd "$(dirname "$0")/.."
+CC=${CC:-cc}
+CFLAGS=${CFLAGS:-"-std=c11 -O2 -Wall"}
+OUT=${OUT:-/tmp/gc9a01a_host}
+mkdir -p "$OUT"
+
+# build <program> <source> [flags]: the driver, the emulated panel and one program.
+# A program that includes a driver file, to reach its static functions, replaces it.
+build() {
+    name=$1
+    src=$2
+    shift 2
+    included=$(sed -n 's/^#include "\(.*\.c\)"$/\1/p' "host/$src")
+    driver=$(ls *.c | grep -v -x -F "${included:-none}")
+    $CC $CFLAGS -I. -Ihost "$@" -o "$OUT/$name" $driver host/gc9a01a_host.c "host/$src" \
+        -lpthread -lm
+}
+
+# the threaded DMA bus must send the same bytes as the polled one
+for mode in "" "-DGC9A01A_FRAMEBUFFER=1" "-DGC9A01A_BAND_LINES=16"; do
+    build dma_polled dma_check.c $mode
+    build dma_threaded dma_check.c $mode -DUSE_DMA=1
+    polled=$("$OUT/dma_polled")
+    threaded=$("$OUT/dma_threaded")
+    echo "dma_check ${mode:-direct}: $threaded"
+    if [ "$polled" != "$threaded" ]; then
+        echo "polled build: $polled"
+        exit 1
+    fi
+done
+
+# the panel must show what was drawn, however windows were reused
+for mode in "" "-DUSE_DMA=1" "-DGC9A01A_FRAMEBUFFER=1"; do
+    build window_check window_check.c $mode
+    echo "window_check ${mode:-direct}"
+    "$OUT/window_check"
+done
+
+# GC9A01A_FRAME_DIFF must not skip pixels that an earlier rectangle left unsent
+for mode in "-DGC9A01A_FRAMEBUFFER=1" "-DGC9A01A_BAND_LINES=16"; do
+    for diff in 1 2; do
+        build diff_check diff_check.c $mode -DGC9A01A_FRAME_DIFF=$diff
+        echo "diff_check $mode -DGC9A01A_FRAME_DIFF=$diff"
+        "$OUT/diff_check"
+    done
+done
+
+# benchmarks, with the kernels the host compiler enables
+build blend_bench blend_bench.c
+"$OUT/blend_bench"
+for mode in "-DGC9A01A_FRAMEBUFFER=1" "-DGC9A01A_BAND_LINES=16"; do
+    build sprite_bench sprite_bench.c $mode
+    echo "sprite_bench $mode"
+    "$OUT/sprite_bench"
+done
+for mode in "" "-DGC9A01A_FRAMEBUFFER=1"; do
+    build triangle_bench triangle_bench.c $mode
+    echo "triangle_bench ${mode:-direct}"
+    "$OUT/triangle_bench"
+done
@@ -0,0 +1,142 @@
+/**
+ *****************************************************************************
+ * @file    sprite_bench.c
+ * @author  Nabli Hatem
+ * @brief   Move eight 24x24 sprites over an image background every frame and
+ *          report the bytes sent per frame, read from the counters of the
+ *          in-memory bus, and the bus rate they need at 30 frames per second.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "gc9a01a.h"
+#include "gc9a01a_blend.h"
+#include "gc9a01a_memory.h"
+#include "gc9a01a_sprite.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#define SPRITES 8
+#define SIZE 24
+#define FRAMES 300
+#define FPS 30
+
+static uint16_t background[GC9A01A_TFTWIDTH * GC9A01A_TFTHEIGHT];
+static uint16_t image[SIZE * SIZE];
+static uint8_t mask[SIZE * SIZE];
+
+static void draw_background(int16_t x, int16_t y, const void *data) {
+    (void)data;
+    gc9a01a_draw_image(x, y, GC9A01A_TFTWIDTH, GC9A01A_TFTHEIGHT, background);
+}
+
+static void draw_ball(int16_t x, int16_t y, const void *data) {
+    gc9a01a_fill_circle(x + SIZE / 2 - 1, y + SIZE / 2 - 1, SIZE / 2 - 1,
+                        (uint16_t)(uintptr_t)data);
+}
+
+static void draw_image(int16_t x, int16_t y, const void *data) {
+    (void)data;
+    gc9a01a_draw_image(x, y, SIZE, SIZE, image);
+}
+
+static void draw_glow(int16_t x, int16_t y, const void *data) {
+    (void)data;
+    gc9a01a_draw_alpha_mask(x, y, SIZE, SIZE, mask, 0xFFE0);
+}
+
+// bytes the bus has carried since the last call
+static uint32_t bytes_sent(void) {
+    gc9a01a_memory_counters_t counters;
+
+    gc9a01a_memory_get_counters(&counters);
+    gc9a01a_memory_reset();
+    return counters.commands + counters.data_bytes;
+}
+
+int main(void) {
+    static const gc9a01a_layer_fn draw[3] = {draw_ball, draw_image, draw_glow};
+    gc9a01a_sprite_t sprites[SPRITES] = {0};
+    int16_t dx[SPRITES], dy[SPRITES];
+    uint32_t bytes, total = 0, most = 0, full;
+    int32_t x, y, r;
+    uint16_t frame;
+    uint8_t i;
+
+    for (y = 0; y < GC9A01A_TFTHEIGHT; y++)
+    {
+        for (x = 0; x < GC9A01A_TFTWIDTH; x++)
+        {
+            background[y * GC9A01A_TFTWIDTH + x] = (x >> 3) << 11 | (y >> 2) << 5 | ((x + y) >> 4);
+        }
+    }
+    for (i = 0; i < SIZE; i++)
+    {
+        for (x = 0; x < SIZE; x++)
+        {
+            r = (i - SIZE / 2) * (i - SIZE / 2) + (x - SIZE / 2) * (x - SIZE / 2);
+            image[i * SIZE + x] = 0x07E0 ^ (i * 37 + x);
+            mask[i * SIZE + x] = (r < 100) ? 255 : ((r < 144) ? (144 - r) * 5 : 0);
+        }
+    }
+
+    gc9a01a_set_transport(&gc9a01a_memory_transport);
+    gc9a01a_init();
+    gc9a01a_flush();
+    gc9a01a_wait_idle();
+    bytes_sent();
+    gc9a01a_sprites_init(draw_background, NULL);
+    for (i = 0; i < SPRITES; i++)
+    {
+        sprites[i].x = 20 + i * 22;
+        sprites[i].y = 30 + i * 18;
+        sprites[i].width = SIZE;
+        sprites[i].height = SIZE;
+        sprites[i].z = i % 3;
+        sprites[i].visible = 1;
+        sprites[i].draw = draw[i % 3];
+        sprites[i].data = (const void *)(uintptr_t)(0xF800 + i * 0x111);
+        dx[i] = 1 + i % 4;
+        dy[i] = 2 - i % 3;
+        gc9a01a_sprite_add(&sprites[i]);
+    }
+    gc9a01a_sprites_update();
+    gc9a01a_wait_idle();
+    full = bytes_sent();
+
+    for (frame = 0; frame < FRAMES; frame++)
+    {
+        // bounce off the edges of the screen
+        for (i = 0; i < SPRITES; i++)
+        {
+            sprites[i].x += dx[i];
+            sprites[i].y += dy[i];
+            if ((sprites[i].x < -10) || (sprites[i].x > GC9A01A_TFTWIDTH - SIZE + 10))
+            { dx[i] = -dx[i]; }
+            if ((sprites[i].y < -10) || (sprites[i].y > GC9A01A_TFTHEIGHT - SIZE + 10))
+            { dy[i] = -dy[i]; }
+        }
+        gc9a01a_sprites_update();
+        gc9a01a_wait_idle();
+        bytes = bytes_sent();
+        total += bytes;
+        if (bytes > most)
+        { most = bytes; }
+    }
+
+    printf("%u sprites %ux%u: %u bytes/frame on average, %u at most, %u for the first "
+           "full frame\n",
+           SPRITES, SIZE, SIZE, (unsigned)(total / FRAMES), (unsigned)most, (unsigned)full);
+    printf("at %u fps: %.0f KB/s of bus traffic instead of %.0f KB/s for full frames\n", FPS,
+           (double)total / FRAMES * FPS / 1024, (double)full * FPS / 1024);
+    return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ *****************************************************************************
+ * @file    triangle_bench.c
+ * @author  Nabli Hatem
+ * @brief   Fill a fixed set of random triangles and print the triangles per
+ *          second, for small and large triangles. Built with
+ *          GC9A01A_FRAMEBUFFER it times the rasterizer alone, otherwise the
+ *          pixels also go through the in-memory bus.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#define _POSIX_C_SOURCE 200809L  ///< clock_gettime() with -std=c11
+
+#include "gc9a01a.h"
+#include "gc9a01a_memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define TRIANGLES 4096  ///< Random triangles, drawn in turn
+#define DRAWS 200000    ///< Triangles drawn per box size
+
+static int16_t vertices[TRIANGLES][6];
+
+static double now(void) {
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// every triangle has its three corners in a random box of size x size pixels
+static void make_triangles(int16_t size) {
+    int16_t x, y;
+    uint16_t i;
+    uint8_t k;
+
+    srand(3);
+    for (i = 0; i < TRIANGLES; i++)
+    {
+        x = rand() % (GC9A01A_TFTWIDTH - size);
+        y = rand() % (GC9A01A_TFTHEIGHT - size);
+        for (k = 0; k < 3; k++)
+        {
+            vertices[i][2 * k] = x + rand() % size;
+            vertices[i][2 * k + 1] = y + rand() % size;
+        }
+    }
+}
+
+int main(void) {
+    static const int16_t sizes[] = {32, 120};
+    const int16_t *v;
+    double start, seconds;
+    uint32_t i;
+    uint8_t s;
+
+    gc9a01a_set_transport(&gc9a01a_memory_transport);
+    gc9a01a_init();
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        make_triangles(sizes[s]);
+        start = now();
+        for (i = 0; i < DRAWS; i++)
+        {
+            v = vertices[i % TRIANGLES];
+            gc9a01a_fill_triangle(v[0], v[1], v[2], v[3], v[4], v[5], (uint16_t)i);
+        }
+        seconds = now() - start;
+        gc9a01a_flush();
+        gc9a01a_wait_idle();
+        printf("%3d-pixel boxes: %9.0f triangles/s\n", sizes[s], DRAWS / seconds);
+    }
+    return 0;
+}
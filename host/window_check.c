@@ -0,0 +1,172 @@
+/**
+ *****************************************************************************
+ * @file    window_check.c
+ * @author  Nabli Hatem
+ * @brief   Draw rectangles, lines and pixels and compare the emulated panel
+ *          with the image they should give, pixel by pixel. Consecutive
+ *          draws reuse the address window and continue memory writes, so a
+ *          continuation that resumes at the wrong column shows up here.
+ *****************************************************************************
+ * @attention
+ *
+ * Copyright © 2025 Nabli Hatem
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+
+#include "gc9a01a.h"
+#include "gc9a01a_host.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// banded frames repaint the whole drawn area, so only these builds keep
+// what earlier draws left on the panel
+#if GC9A01A_ROUND_MASK || GC9A01A_BAND_LINES
+#error "window_check needs the direct or framebuffer build without GC9A01A_ROUND_MASK"
+#endif
+
+static uint16_t expected[GC9A01A_TFTWIDTH * GC9A01A_TFTHEIGHT];
+static uint32_t failures = 0;
+
+// what a filled rectangle clipped to the screen should leave on the panel
+static void expect_rectangle(int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color) {
+    int16_t i, j;
+
+    for (j = y; j < y + height; j++)
+    {
+        for (i = x; i < x + width; i++)
+        {
+            if ((i >= 0) && (i < GC9A01A_TFTWIDTH) && (j >= 0) && (j < GC9A01A_TFTHEIGHT))
+            { expected[j * GC9A01A_TFTWIDTH + i] = color; }
+        }
+    }
+}
+
+static void check(const char *name) {
+    const uint16_t *panel;
+    uint32_t i, wrong = 0;
+
+    gc9a01a_flush();
+    gc9a01a_wait_idle();
+    panel = gc9a01a_host_panel();
+    for (i = 0; i < GC9A01A_TFTWIDTH * GC9A01A_TFTHEIGHT; i++)
+    {
+        if (panel[i] != expected[i])
+        { wrong++; }
+    }
+    printf("%-40s %s (%u pixels wrong)\n", name, wrong ? "FAIL" : "ok", (unsigned)wrong);
+    if (wrong)
+    { failures++; }
+}
+
+static void clear(void) {
+    gc9a01a_fill_screen(0x0000);
+    expect_rectangle(0, 0, GC9A01A_TFTWIDTH, GC9A01A_TFTHEIGHT, 0x0000);
+}
+
+int main(void) {
+    int16_t x, y, w, h;
+    uint16_t color, n;
+
+#if USE_DMA
+    gc9a01a_set_transport(&gc9a01a_host_threaded_transport);
+#else
+    gc9a01a_set_transport(&gc9a01a_host_transport);
+#endif
+    gc9a01a_init();
+
+    // a rectangle starting where a line left the cursor, sharing its right edge
+    clear();
+    gc9a01a_draw_fast_horizental_line(0, 0, 120, 0xF800);
+    expect_rectangle(0, 0, 120, 1, 0xF800);
+    gc9a01a_fill_rectangle(120, 0, 120, GC9A01A_TFTHEIGHT, 0x07E0);
+    expect_rectangle(120, 0, 120, GC9A01A_TFTHEIGHT, 0x07E0);
+    check("line then rectangle at the cursor");
+
+    // pixels and a rectangle continuing from them
+    clear();
+    gc9a01a_write_pixel(10, 20, 0xFFFF);
+    expect_rectangle(10, 20, 1, 1, 0xFFFF);
+    gc9a01a_fill_rectangle(11, 20, 229, 50, 0x001F);
+    expect_rectangle(11, 20, 229, 50, 0x001F);
+    check("pixel then rectangle at the cursor");
+
+    // random sequences, the next draw often starts where the last one ended
+    clear();
+    srand(5);
+    x = 0;
+    y = 0;
+    for (n = 0; n < 5000; n++)
+    {
+        color = rand();
+        // spans often reach the right or bottom edge, where windows line up
+        w = (rand() % 3) ? 1 + rand() % 60 : GC9A01A_TFTWIDTH;
+        h = (rand() % 3) ? 1 + rand() % 40 : GC9A01A_TFTHEIGHT;
+        if (rand() % 4 == 0)
+        {
+            x = (rand() % 2) ? rand() % GC9A01A_TFTWIDTH : 0;
+            y = rand() % GC9A01A_TFTHEIGHT;
+        }
+        switch (rand() % 4)
+        {
+        case 0:
+            gc9a01a_fill_rectangle(x, y, w, h, color);
+            expect_rectangle(x, y, w, h, color);
+            break;
+        case 1:
+            gc9a01a_draw_fast_horizental_line(x, y, w, color);
+            expect_rectangle(x, y, w, 1, color);
+            break;
+        case 2:
+            gc9a01a_draw_fast_vertical_line(x, y, h, color);
+            expect_rectangle(x, y, 1, h, color);
+            w = 1;
+            break;
+        default:
+            gc9a01a_write_pixel(x, y, color);
+            expect_rectangle(x, y, 1, 1, color);
+            w = 1;
+            break;
+        }
+        // go on right after it, or at the start of the next row
+        x += w;
+        if (x >= GC9A01A_TFTWIDTH)
+        {
+            x = 0;
+            y = (y + 1) % GC9A01A_TFTHEIGHT;
+        }
+        if ((n % 500) == 499)
+        { check("random rectangles, lines and pixels"); }
+    }
+
+    // a window reaching the right and bottom edges, a span from its corner,
+    // then a rectangle from the cursor to the same edges
+    clear();
+    for (n = 0; n < 2000; n++)
+    {
+        x = rand() % (GC9A01A_TFTWIDTH - 1);
+        y = rand() % GC9A01A_TFTHEIGHT;
+        w = 1 + rand() % (GC9A01A_TFTWIDTH - 1 - x);
+        color = rand();
+        gc9a01a_fill_rectangle(x, y, GC9A01A_TFTWIDTH - x, GC9A01A_TFTHEIGHT - y, color);
+        expect_rectangle(x, y, GC9A01A_TFTWIDTH - x, GC9A01A_TFTHEIGHT - y, color);
+        color = rand();
+        if (w == 1)
+        {
+            gc9a01a_write_pixel(x, y, color);
+        } else
+        { gc9a01a_draw_fast_horizental_line(x, y, w, color); }
+        expect_rectangle(x, y, w, 1, color);
+        color = rand();
+        gc9a01a_fill_rectangle(x + w, y, GC9A01A_TFTWIDTH - x - w, GC9A01A_TFTHEIGHT - y, color);
+        expect_rectangle(x + w, y, GC9A01A_TFTWIDTH - x - w, GC9A01A_TFTHEIGHT - y, color);
+        if ((n % 200) == 199)
+        { check("spans continued to the window edges"); }
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,414 @@
+#!/usr/bin/env python3
+# @file    gc9a01a_font.py
+# @author  Nabli Hatem
+# @brief   Convert a font into a gc9a01a_aa_font_t or gc9a01a_prop_font_t C
+#          array, see gc9a01a_font.h for the layouts.
+#
+# Copyright © 2025 Nabli Hatem
+# All rights reserved.
+#
+# This software is licensed under terms that can be found in the LICENSE file
+# in the root directory of this software component.
+# If no LICENSE file comes with this software, it is provided AS-IS.
+"""Convert a font into an anti-aliased, proportional or packed glcd C array.
+
+TrueType fonts are rendered with Pillow at --size pixels, BDF bitmap fonts
+are read directly. Without Pillow, one of the glcdfont.c fonts can also be
+downsampled by --scale with a box filter, which gives a smooth font of a
+smaller size from a large 1 bpp one.
+
+--format selects the output:
+  aa    fixed-cell 2 or 4 bpp gc9a01a_aa_font_t of ASCII (default).
+  prop  gc9a01a_prop_font_t with 1, 2 or 4 bpp glyphs trimmed to their ink,
+        per-glyph advances and the code points of --ranges (glcdfont.c
+        fonts only have ASCII). -p is a shorthand.
+  glcd  1 bpp glcd_font_t of ASCII stored as a bitstream, for
+        gc9a01a_write_string(). Cells are at most 16 pixels wide.
+
+    gc9a01a_font.py --ttf DejaVuSans.ttf --size 16 -n dejavu_16 -o dejavu_16.c
+    gc9a01a_font.py --glcd font_16_x_26 --scale 2 -n smooth_8_x_13 -o smooth.c
+    gc9a01a_font.py --ttf DejaVuSans.ttf --size 14 -p -b 2 \
+        --ranges 0x20-0x7E,0xA0-0xFF,0x400-0x45F -n ui_14 -o ui_14.c
+    gc9a01a_font.py --bdf 6x13.bdf -f glcd -n font_6_x_13 -o font_6_x_13.c
+"""
+
+import argparse
+import os
+import re
+import sys
+
+FIRST = 32
+LAST = 126
+
+
+def read_glcd(path, name):
+    with open(path) as f:
+        source = f.read()
+    match = re.search(r"%s_(?:data|bits)\[\][^{]*\{(.*?)\};" % re.escape(name), source, re.S)
+    size = re.search(r"%s\s*=\s*\{\s*(\d+)\s*,\s*(\d+)" % re.escape(name), source)
+    if match is None or size is None:
+        sys.exit("%s: no font %s" % (path, name))
+    width, height = int(size.group(1)), int(size.group(2))
+    body = re.sub(r"//[^\n]*", "", match.group(1))
+    values = [int(v, 16) for v in re.findall(r"0x[0-9A-Fa-f]+", body)]
+    if match.group(0).startswith(name + "_bits"):
+        # packed: rows follow each other bit after bit
+        bits = "".join("{:08b}".format(v) for v in values)
+        rows = [int(bits[i * width:(i + 1) * width].ljust(16, "0"), 2)
+                for i in range((LAST - FIRST + 1) * height)]
+    else:
+        rows = values
+    glyphs = []
+    for c in range(LAST - FIRST + 1):
+        glyph = rows[c * height:(c + 1) * height]
+        glyphs.append([[255 if (row << x) & 0x8000 else 0 for x in range(width)]
+                       for row in glyph])
+    return width, height, glyphs
+
+
+def downsample(width, height, glyphs, scale):
+    out_width, out_height = -(-width // scale), -(-height // scale)
+    out = []
+    for glyph in glyphs:
+        cells = []
+        for y in range(out_height):
+            row = []
+            for x in range(out_width):
+                total = sum(glyph[sy][sx]
+                            for sy in range(y * scale, min((y + 1) * scale, height))
+                            for sx in range(x * scale, min((x + 1) * scale, width)))
+                row.append(total // (scale * scale))
+            cells.append(row)
+        out.append(cells)
+    return out_width, out_height, out
+
+
+def read_ttf(path, size):
+    try:
+        from PIL import Image, ImageDraw, ImageFont
+    except ImportError:
+        sys.exit("--ttf needs Pillow, use --glcd without it")
+    font = ImageFont.truetype(path, size)
+    ascent, descent = font.getmetrics()
+    height = ascent + descent
+    width = max(int(round(font.getlength(chr(c)))) for c in range(FIRST, LAST + 1))
+    glyphs = []
+    for c in range(FIRST, LAST + 1):
+        image = Image.new("L", (width, height), 0)
+        ImageDraw.Draw(image).text((0, 0), chr(c), fill=255, font=font)
+        pixels = list(image.getdata())
+        glyphs.append([pixels[y * width:(y + 1) * width] for y in range(height)])
+    return width, height, glyphs
+
+
+def read_bdf(path):
+    """Glyphs of a BDF font: code point -> (advance, x, y, rows), x and y
+    placing the bitmap from the pen position and the top of the line."""
+    ascent = descent = None
+    glyphs = {}
+    with open(path, encoding="latin-1") as f:
+        lines = iter(f.read().splitlines())
+    for line in lines:
+        words = line.split()
+        if not words:
+            continue
+        if words[0] == "FONTBOUNDINGBOX" and ascent is None:
+            ascent, descent = int(words[2]) + int(words[4]), -int(words[4])
+        elif words[0] == "FONT_ASCENT":
+            ascent = int(words[1])
+        elif words[0] == "FONT_DESCENT":
+            descent = int(words[1])
+        elif words[0] == "STARTCHAR":
+            code, advance, box = -1, 0, (0, 0, 0, 0)
+            for line in lines:
+                words = line.split()
+                if words[0] == "ENCODING":
+                    code = int(words[1])
+                elif words[0] == "DWIDTH":
+                    advance = int(words[1])
+                elif words[0] == "BBX":
+                    box = tuple(int(v) for v in words[1:5])
+                elif words[0] == "BITMAP":
+                    break
+            width, height, x, y = box
+            rows = []
+            for _ in range(height):
+                text = next(lines).strip()
+                value, bits = int(text, 16), 4 * len(text)
+                rows.append([255 if (value >> (bits - 1 - i)) & 1 else 0 for i in range(width)])
+            if code >= 0:
+                glyphs[code] = (advance, x, ascent - (y + height), rows)
+    if ascent is None:
+        sys.exit("%s: not a BDF font" % path)
+    return ascent, descent, glyphs
+
+
+def bdf_proportional(path, codes):
+    ascent, descent, glyphs = read_bdf(path)
+    out = {code: trim(*glyphs[code]) for code in codes if code in glyphs}
+    return ascent + descent, ascent, out
+
+
+def bdf_cells(path):
+    """Fixed cells of the ASCII glyphs of a BDF font."""
+    ascent, descent, glyphs = read_bdf(path)
+    ascii_glyphs = [glyphs.get(c, (0, 0, 0, [])) for c in range(FIRST, LAST + 1)]
+    left = min([0] + [x for _, x, _, rows in ascii_glyphs if rows])
+    width = max(max(advance, x - left + (len(rows[0]) if rows else 0))
+                for advance, x, _, rows in ascii_glyphs)
+    height = ascent + descent
+    cells = []
+    for advance, x, y, rows in ascii_glyphs:
+        cell = [[0] * width for _ in range(height)]
+        for j, row in enumerate(rows):
+            for i, v in enumerate(row):
+                if 0 <= y + j < height:
+                    cell[y + j][x - left + i] = v
+        cells.append(cell)
+    return width, height, cells
+
+
+def parse_ranges(text):
+    codes = []
+    for part in text.split(","):
+        first, _, last = part.partition("-")
+        codes.extend(range(int(first, 0), int(last or first, 0) + 1))
+    return sorted(set(codes))
+
+
+def trim(advance, x_offset, y_offset, rows):
+    """Crop a glyph bitmap to its ink, moving the offsets along."""
+    ink_rows = [y for y, row in enumerate(rows) if any(row)]
+    if not ink_rows:
+        return advance, 0, 0, []
+    ink_cols = [x for x in range(len(rows[0])) if any(row[x] for row in rows)]
+    x0, x1, y0, y1 = ink_cols[0], ink_cols[-1], ink_rows[0], ink_rows[-1]
+    return (advance, x_offset + x0, y_offset + y0,
+            [row[x0:x1 + 1] for row in rows[y0:y1 + 1]])
+
+
+def proportional_cells(width, height, glyphs):
+    """Proportional glyphs of a fixed-cell font: the ink of each glyph and
+    one column of spacing, a space half a cell wide."""
+    out = {}
+    for c, rows in enumerate(glyphs):
+        advance, x_offset, y_offset, ink = trim(width, 0, 0, rows)
+        if ink:
+            # the column after the ink keeps glyphs apart
+            advance = len(ink[0]) + 1
+            x_offset = 0
+        else:
+            advance = max(2, width // 2)
+        out[FIRST + c] = (advance, x_offset, y_offset, ink)
+    # the baseline is under the ink of H
+    advance, x_offset, y_offset, ink = out[ord("H")]
+    return height, y_offset + len(ink), out
+
+
+def read_ttf_proportional(path, size, codes):
+    try:
+        from PIL import Image, ImageDraw, ImageFont
+    except ImportError:
+        sys.exit("--ttf needs Pillow, use --glcd without it")
+    font = ImageFont.truetype(path, size)
+    ascent, descent = font.getmetrics()
+    out = {}
+    for code in codes:
+        left, top, right, bottom = font.getbbox(chr(code))
+        advance = int(round(font.getlength(chr(code))))
+        rows = []
+        if right > left and bottom > top:
+            image = Image.new("L", (right - left, bottom - top), 0)
+            ImageDraw.Draw(image).text((-left, -top), chr(code), fill=255, font=font)
+            pixels = list(image.getdata())
+            rows = [pixels[y * image.width:(y + 1) * image.width] for y in range(image.height)]
+        out[code] = trim(advance, left, top, rows) if rows else (advance, 0, 0, [])
+    return ascent + descent, ascent, out
+
+
+def pack_rows(rows, bpp):
+    top = (1 << bpp) - 1
+    out = bytearray()
+    for row in rows:
+        byte, used = 0, 0
+        for v in row:
+            byte = (byte << bpp) | ((v * top + 127) // 255)
+            used += bpp
+            if used == 8:
+                out.append(byte)
+                byte, used = 0, 0
+        if used:
+            out.append(byte << (8 - used))
+    return bytes(out)
+
+
+def to_c_proportional(name, height, baseline, bpp, glyphs):
+    codes = sorted(glyphs)
+    bitmap = bytearray()
+    entries = []
+    for code in codes:
+        advance, x_offset, y_offset, rows = glyphs[code]
+        if not -128 <= x_offset <= 127 or not -128 <= y_offset <= 127 or advance > 255:
+            sys.exit("U+%04X: metrics do not fit the glyph table" % code)
+        width = len(rows[0]) if rows else 0
+        entries.append("    {%d, %d, %d, %d, %d, %d},  // U+%04X %s"
+                       % (len(bitmap), width, len(rows), advance, x_offset, y_offset, code,
+                          repr(chr(code)) if chr(code).isprintable() else ""))
+        bitmap += pack_rows(rows, bpp)
+    ranges = []
+    for i, code in enumerate(codes):
+        if ranges and code == ranges[-1][0] + ranges[-1][1] and ranges[-1][1] < 0xFFFF:
+            ranges[-1][1] += 1
+        else:
+            ranges.append([code, 1, i])
+    fallback = codes.index(ord("?")) if ord("?") in glyphs else 0
+    lines = [
+        "/* Generated by tools/gc9a01a_font.py, %d px lines, %d bpp, %d glyphs, %d bytes */"
+        % (height, bpp, len(codes), len(bitmap) + 12 * len(codes) + 8 * len(ranges)),
+        '#include "gc9a01a_font.h"',
+        "",
+        "static const uint8_t %s_bitmap[] = {" % name,
+    ]
+    for i in range(0, len(bitmap), 16):
+        lines.append("    " + " ".join("0x%02X," % b for b in bitmap[i:i + 16]))
+    lines += ["};", "", "static const gc9a01a_glyph_t %s_glyphs[] = {" % name]
+    lines += entries
+    lines += ["};", "", "static const gc9a01a_code_range_t %s_ranges[] = {" % name]
+    lines += ["    {0x%04X, %d, %d}," % tuple(r) for r in ranges]
+    lines += [
+        "};",
+        "",
+        "const gc9a01a_prop_font_t %s = {%d, %d, %d, %d, %s_bitmap, %s_glyphs, %s_ranges, %d};"
+        % (name, height, baseline, bpp, fallback, name, name, name, len(ranges)),
+        "",
+    ]
+    return "\n".join(lines), len(codes), len(bitmap)
+
+
+def pack(glyphs, bpp):
+    return b"".join(pack_rows(glyph, bpp) for glyph in glyphs)
+
+
+def to_c_glcd(name, width, height, glyphs):
+    if width > 16:
+        sys.exit("glcd fonts are at most 16 pixels wide, %s is %d" % (name, width))
+    bits = "".join("1" if v >= 128 else "0" for glyph in glyphs for row in glyph for v in row)
+    bits += "0" * (-len(bits) % 8)
+    data = [int(bits[i:i + 8], 2) for i in range(0, len(bits), 8)]
+    lines = [
+        "/* Generated by tools/gc9a01a_font.py, %dx%d, %d bytes (%d as 16-bit rows) */"
+        % (width, height, len(data), 2 * height * len(glyphs)),
+        '#include "glcdfont.h"',
+        "",
+        "static const uint8_t %s_bits[] = {" % name,
+    ]
+    for i in range(0, len(data), 16):
+        lines.append("    " + " ".join("0x%02X," % b for b in data[i:i + 16]))
+    lines += [
+        "};",
+        "",
+        "glcd_font_t %s = {%d, %d, NULL, %s_bits};" % (name, width, height, name),
+        "",
+    ]
+    return "\n".join(lines), len(data)
+
+
+def to_c(name, width, height, bpp, data):
+    lines = [
+        "/* Generated by tools/gc9a01a_font.py, %dx%d, %d bpp, %d bytes */"
+        % (width, height, bpp, len(data)),
+        '#include "gc9a01a_font.h"',
+        "",
+        "static const uint8_t %s_data[] = {" % name,
+    ]
+    stride = (width * bpp + 7) // 8 * height
+    for c in range(LAST - FIRST + 1):
+        glyph = data[c * stride:(c + 1) * stride]
+        for i in range(0, len(glyph), 16):
+            line = "    " + " ".join("0x%02X," % b for b in glyph[i:i + 16])
+            if i == 0:
+                line += "  // %s" % ("sp" if c == 0 else chr(FIRST + c))
+            lines.append(line)
+    lines += [
+        "};",
+        "",
+        "const gc9a01a_aa_font_t %s = {%d, %d, %d, %d, %d, %s_data};"
+        % (name, width, height, bpp, FIRST, LAST, name),
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def write(path, source):
+    if path:
+        with open(path, "w") as f:
+            f.write(source)
+    else:
+        sys.stdout.write(source)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0],
+                                     formatter_class=argparse.RawDescriptionHelpFormatter,
+                                     epilog="\n".join(__doc__.splitlines()[2:]))
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--ttf", metavar="FILE", help="TrueType or OpenType font")
+    source.add_argument("--bdf", metavar="FILE", help="BDF bitmap font")
+    source.add_argument("--glcd", metavar="NAME", help="font of glcdfont.c, e.g. font_16_x_26")
+    parser.add_argument("--size", type=int, default=16, help="pixel size of --ttf")
+    parser.add_argument("--scale", type=int, default=1,
+                        help="downsampling factor of --bdf and --glcd fixed cells")
+    parser.add_argument("--glcdfont", metavar="FILE", help="glcdfont.c to read --glcd from",
+                        default=os.path.join(os.path.dirname(__file__), "..", "glcdfont.c"))
+    parser.add_argument("-f", "--format", choices=("aa", "prop", "glcd"), default="aa")
+    parser.add_argument("-p", "--proportional", dest="format", action="store_const", const="prop",
+                        help="same as --format prop")
+    parser.add_argument("--ranges", default="0x20-0x7E",
+                        help="code points of a proportional font, e.g. 0x20-0x7E,0xA0-0xFF")
+    parser.add_argument("-b", "--bpp", type=int, choices=(1, 2, 4), default=4, help="bits per pixel")
+    parser.add_argument("-n", "--name", default="font", help="C symbol of the font")
+    parser.add_argument("-o", "--output", help="C file to write, stdout by default")
+    args = parser.parse_args()
+
+    if args.format == "prop":
+        if args.ttf:
+            height, baseline, glyphs = read_ttf_proportional(args.ttf, args.size,
+                                                             parse_ranges(args.ranges))
+        elif args.bdf and args.scale == 1:
+            height, baseline, glyphs = bdf_proportional(args.bdf, parse_ranges(args.ranges))
+        else:
+            if args.bdf:
+                width, height, glyphs = bdf_cells(args.bdf)
+            else:
+                width, height, glyphs = read_glcd(args.glcdfont, args.glcd)
+            height, baseline, glyphs = proportional_cells(
+                *downsample(width, height, glyphs, args.scale))
+        source, count, size = to_c_proportional(args.name, height, baseline, args.bpp, glyphs)
+        write(args.output, source)
+        sys.stderr.write("%s: %d px lines, %d bpp, %d glyphs, %d bytes of bitmap\n"
+                         % (args.name, height, args.bpp, count, size))
+        return
+
+    if args.ttf:
+        width, height, glyphs = read_ttf(args.ttf, args.size)
+    else:
+        if args.bdf:
+            width, height, glyphs = bdf_cells(args.bdf)
+        else:
+            width, height, glyphs = read_glcd(args.glcdfont, args.glcd)
+        width, height, glyphs = downsample(width, height, glyphs, args.scale)
+    if args.format == "glcd":
+        source, size = to_c_glcd(args.name, width, height, glyphs)
+        write(args.output, source)
+        sys.stderr.write("%s: %dx%d, %d bytes\n" % (args.name, width, height, size))
+        return
+    if args.bpp == 1:
+        sys.exit("fixed-cell anti-aliased fonts are 2 or 4 bpp")
+    data = pack(glyphs, args.bpp)
+    write(args.output, to_c(args.name, width, height, args.bpp, data))
+    sys.stderr.write("%s: %dx%d, %d bpp, %d bytes\n" % (args.name, width, height, args.bpp,
+                                                       len(data)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+# @file    gc9a01a_indexed.py
+# @author  Nabli Hatem
+# @brief   Convert an image into a gc9a01a_indexed_image_t C array, see
+#          gc9a01a_indexed.h for the layout.
+#
+# Copyright © 2025 Nabli Hatem
+# All rights reserved.
+#
+# This software is licensed under terms that can be found in the LICENSE file
+# in the root directory of this software component.
+# If no LICENSE file comes with this software, it is provided AS-IS.
+"""Convert an image of at most 256 colors into a palette-indexed C array.
+
+The smallest of 1, 2, 4 or 8 bits per pixel holding every RGB565 color of
+the image is used unless --bpp is given. Inputs are read as by
+gc9a01a_rle.py.
+
+    gc9a01a_indexed.py icon.png -n icon -t 0xF81F -o icon.c
+"""
+
+import argparse
+import sys
+
+from gc9a01a_rle import read_image
+
+
+def build_palette(pixels, transparent):
+    palette = [transparent] if transparent is not None else []
+    for p in pixels:
+        if p not in palette:
+            palette.append(p)
+    return palette
+
+
+def pack(pixels, width, bpp, palette):
+    index = {color: i for i, color in enumerate(palette)}
+    out = bytearray()
+    for y in range(0, len(pixels), width):
+        byte, used = 0, 0
+        for p in pixels[y:y + width]:
+            byte = (byte << bpp) | index[p]
+            used += bpp
+            if used == 8:
+                out.append(byte)
+                byte, used = 0, 0
+        if used:
+            out.append(byte << (8 - used))
+    return bytes(out)
+
+
+def to_c(name, width, height, bpp, palette, data):
+    lines = [
+        "/* Generated by tools/gc9a01a_indexed.py, %dx%d, %d bpp, %d bytes (%d as RGB565) */"
+        % (width, height, bpp, len(data) + 2 * len(palette), 2 * width * height),
+        '#include "gc9a01a_indexed.h"',
+        "",
+        "static const uint16_t %s_palette[%d] = {" % (name, 1 << bpp),
+    ]
+    for i in range(0, len(palette), 8):
+        lines.append("    " + " ".join("0x%04X," % c for c in palette[i:i + 8]))
+    lines += ["};", "", "static const uint8_t %s_data[] = {" % name]
+    for i in range(0, len(data), 16):
+        lines.append("    " + " ".join("0x%02X," % b for b in data[i:i + 16]))
+    lines += [
+        "};",
+        "",
+        "const gc9a01a_indexed_image_t %s = {%d, %d, %d, %s_data, %s_palette};"
+        % (name, width, height, bpp, name, name),
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("image")
+    parser.add_argument("-n", "--name", default="image", help="C symbol of the image")
+    parser.add_argument("-o", "--output", help="C file to write, stdout by default")
+    parser.add_argument("-b", "--bpp", type=int, choices=(1, 2, 4, 8), help="bits per pixel")
+    parser.add_argument("-t", "--transparent", type=lambda v: int(v, 0), metavar="RGB565",
+                        help="color stored as index 0, to draw with transparency 0")
+    parser.add_argument("--raw", metavar="WxH", help="input is raw RGB565 little-endian")
+    args = parser.parse_args()
+
+    width, height, pixels = read_image(args.image, args.raw)
+    palette = build_palette(pixels, args.transparent)
+    bpp = args.bpp or next((b for b in (1, 2, 4, 8) if len(palette) <= 1 << b), None)
+    if bpp is None or len(palette) > 1 << bpp:
+        sys.exit("%s: %d colors do not fit in %s bpp" % (args.image, len(palette), bpp or 8))
+    data = pack(pixels, width, bpp, palette)
+    source = to_c(args.name, width, height, bpp, palette, data)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(source)
+    else:
+        sys.stdout.write(source)
+    sys.stderr.write("%s: %dx%d, %d colors, %d bpp, %d -> %d bytes\n"
+                     % (args.image, width, height, len(palette), bpp, 2 * width * height,
+                        len(data) + 2 * len(palette)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+# @file    gc9a01a_rle.py
+# @author  Nabli Hatem
+# @brief   Convert an image into a gc9a01a_rle_image_t C array, see
+#          gc9a01a_rle.h for the packet format.
+#
+# Copyright © 2025 Nabli Hatem
+# All rights reserved.
+#
+# This software is licensed under terms that can be found in the LICENSE file
+# in the root directory of this software component.
+# If no LICENSE file comes with this software, it is provided AS-IS.
+"""Convert an image into a run-length compressed RGB565 C array.
+
+Any format Pillow can open is accepted when it is installed, binary PPM (P6)
+files are read without it. Raw RGB565 little-endian dumps are read with
+--raw WIDTHxHEIGHT.
+
+    gc9a01a_rle.py splash.png -n splash -o splash_rle.c
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+RUN = 0x80
+MAX_COUNT = 128
+
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def read_ppm(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    fields = []
+    pos = 0
+    while len(fields) < 4:
+        match = re.compile(rb"\s*(#[^\n]*\n\s*)*(\S+)").match(data, pos)
+        if match is None:
+            raise ValueError("%s: truncated PPM header" % path)
+        fields.append(match.group(2))
+        pos = match.end()
+    if fields[0] != b"P6" or int(fields[3]) != 255:
+        raise ValueError("%s: only 8-bit binary PPM (P6) is supported" % path)
+    width, height = int(fields[1]), int(fields[2])
+    pixels = data[pos + 1:pos + 1 + 3 * width * height]
+    return width, height, [rgb565(*pixels[i:i + 3]) for i in range(0, len(pixels), 3)]
+
+
+def read_image(path, raw):
+    if raw:
+        width, height = (int(v) for v in raw.lower().split("x"))
+        with open(path, "rb") as f:
+            data = f.read(2 * width * height)
+        return width, height, list(struct.unpack("<%dH" % (width * height), data))
+    try:
+        from PIL import Image
+    except ImportError:
+        return read_ppm(path)
+    image = Image.open(path).convert("RGB")
+    return image.width, image.height, [rgb565(*p) for p in image.getdata()]
+
+
+def encode(pixels):
+    """Greedy encoder: runs of 2 pixels start a run packet, or 3 when they
+    would interrupt a literal packet, which costs one more control byte."""
+    out = bytearray()
+    literal = []
+
+    def flush_literal():
+        for i in range(0, len(literal), MAX_COUNT):
+            chunk = literal[i:i + MAX_COUNT]
+            out.append(len(chunk) - 1)
+            for p in chunk:
+                out.extend(struct.pack(">H", p))
+        del literal[:]
+
+    i = 0
+    while i < len(pixels):
+        n = 1
+        while i + n < len(pixels) and n < MAX_COUNT and pixels[i + n] == pixels[i]:
+            n += 1
+        if n >= (3 if literal else 2):
+            flush_literal()
+            out.append(RUN | (n - 1))
+            out += struct.pack(">H", pixels[i])
+            i += n
+        else:
+            literal.append(pixels[i])
+            i += 1
+    flush_literal()
+    return bytes(out)
+
+
+def decode(data, count):
+    pixels = []
+    pos = 0
+    while pos < len(data) and len(pixels) < count:
+        n = (data[pos] & 0x7F) + 1
+        if data[pos] & RUN:
+            pixels += [struct.unpack_from(">H", data, pos + 1)[0]] * n
+            pos += 3
+        else:
+            pixels += list(struct.unpack_from(">%dH" % n, data, pos + 1))
+            pos += 1 + 2 * n
+    return pixels
+
+
+def to_c(name, width, height, data):
+    lines = [
+        "/* Generated by tools/gc9a01a_rle.py, %dx%d, %d bytes (%d uncompressed) */"
+        % (width, height, len(data), 2 * width * height),
+        '#include "gc9a01a_rle.h"',
+        "",
+        "static const uint8_t %s_data[] = {" % name,
+    ]
+    for i in range(0, len(data), 16):
+        lines.append("    " + " ".join("0x%02X," % b for b in data[i:i + 16]))
+    lines += [
+        "};",
+        "",
+        "const gc9a01a_rle_image_t %s = {%d, %d, sizeof(%s_data), %s_data};"
+        % (name, width, height, name, name),
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("image")
+    parser.add_argument("-n", "--name", default="image", help="C symbol of the image")
+    parser.add_argument("-o", "--output", help="C file to write, stdout by default")
+    parser.add_argument("--raw", metavar="WxH", help="input is raw RGB565 little-endian")
+    args = parser.parse_args()
+
+    width, height, pixels = read_image(args.image, args.raw)
+    data = encode(pixels)
+    assert decode(data, len(pixels)) == pixels
+    source = to_c(args.name, width, height, data)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(source)
+    else:
+        sys.stdout.write(source)
+    sys.stderr.write("%s: %dx%d, %d -> %d bytes (%.1fx)\n" % (args.image, width, height,
+                     2 * width * height, len(data), 2.0 * width * height / max(len(data), 1)))
+
+
+if __name__ == "__main__":
+    main()